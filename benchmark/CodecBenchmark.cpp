@@ -0,0 +1,356 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: bit_converter 与 util 中各编解码函数的基准测试
+*
+* 编译：
+*   g++ -std=c++17 -O2 -march=native -I../bit_converter -I../util CodecBenchmark.cpp -o codec_benchmark
+* 运行：
+*   ./codec_benchmark [结果文件.json] [过滤关键字]
+*
+* 每项输出 ns/op、bytes/s 与每次调用的堆分配次数，结果以 JSON 输出，便于跨版本对比。
+* 数据集使用固定种子生成，保证每次运行输入一致。
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BitConverter.hpp"
+#include "CoderUtils.hpp"
+#include "Crc16.hpp"
+#include "FrameDecoder.hpp"
+#include "FrameEncoder.hpp"
+#include "FrameRingBuffer.hpp"
+#include "HexCodec.hpp"
+#include "IsoChecksum.hpp"
+#include "StringHex.hpp"
+
+using namespace lanyueuav;
+
+namespace {
+    std::atomic<uint64_t> g_allocations{0};
+
+    const uint32_t SEED = 20240229;
+    const double MIN_SECONDS = 0.2;
+
+    template<typename T>
+    inline void doNotOptimize(const T &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct Result {
+        std::string name;
+        uint64_t iterations;
+        double ns_per_op;
+        double bytes_per_sec;
+        double allocs_per_op;
+    };
+
+    std::vector<Result> g_results;
+    const char *g_filter = nullptr;
+
+    /**
+     * @brief 以翻倍的迭代次数运行直到耗时超过 MIN_SECONDS
+     * @param name 名称
+     * @param bytes_per_op 每次调用处理的字节数，0 表示不统计吞吐
+     * @param op 被测函数
+     */
+    void bench(const std::string &name, size_t bytes_per_op, const std::function<void()> &op) {
+        if (g_filter != nullptr && name.find(g_filter) == std::string::npos) {
+            return;
+        }
+        op();
+        uint64_t iterations = 1;
+        for (;;) {
+            uint64_t allocs = g_allocations.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < iterations; i++) {
+                op();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            allocs = g_allocations.load(std::memory_order_relaxed) - allocs;
+            if (seconds >= MIN_SECONDS || iterations >= (1ull << 40)) {
+                Result result{name, iterations, seconds * 1e9 / iterations,
+                              bytes_per_op ? bytes_per_op * iterations / seconds : 0.0,
+                              static_cast<double>(allocs) / iterations};
+                fprintf(stderr, "%-40s %12.1f ns/op %12.1f MB/s %8.2f allocs/op\n", name.c_str(),
+                        result.ns_per_op, result.bytes_per_sec / 1e6, result.allocs_per_op);
+                g_results.push_back(result);
+                return;
+            }
+            iterations *= 2;
+        }
+    }
+
+    std::vector<unsigned char> randomBytes(std::mt19937 &rng, size_t len) {
+        std::vector<unsigned char> out(len);
+        for (auto &b: out) b = static_cast<unsigned char>(rng());
+        return out;
+    }
+
+    /**
+     * 不含 0xAA 的噪声，findHeaderIndex 的最坏情况
+     */
+    std::vector<unsigned char> noise(std::mt19937 &rng, size_t len) {
+        std::vector<unsigned char> out(len);
+        for (auto &b: out) {
+            do { b = static_cast<unsigned char>(rng()); } while (b == 0xaa);
+        }
+        return out;
+    }
+
+    std::vector<unsigned char> frame(std::mt19937 &rng, uint16_t len) {
+        std::vector<unsigned char> payload = randomBytes(rng, len);
+        std::vector<unsigned char> out;
+        FrameEncoder::encode(out, payload.data(), len, 1, 2, 3, 4);
+        return out;
+    }
+
+    /**
+     * 每包 32 个 double 的遥测数据包
+     */
+    std::vector<unsigned char> floatFrame(std::mt19937 &rng) {
+        std::uniform_real_distribution<double> dist(-1e6, 1e6);
+        std::vector<unsigned char> payload;
+        for (int i = 0; i < 32; i++) BitConverter::f64_to_bytes(dist(rng), false, payload);
+        std::vector<unsigned char> out;
+        FrameEncoder::encode(out, payload.data(), static_cast<uint16_t>(payload.size()), 1, 2, 3, 4);
+        return out;
+    }
+
+    /**
+     * 数据包与噪声交错的接收流，约四分之一的包被破坏
+     */
+    std::vector<unsigned char> noisyStream(std::mt19937 &rng, size_t frames) {
+        std::vector<unsigned char> out;
+        for (size_t i = 0; i < frames; i++) {
+            std::vector<unsigned char> n = noise(rng, rng() % 32);
+            out.insert(out.end(), n.begin(), n.end());
+            std::vector<unsigned char> f = frame(rng, static_cast<uint16_t>(16 + rng() % 64));
+            if (rng() % 4 == 0) f[f.size() / 2] ^= 0x5a;
+            out.insert(out.end(), f.begin(), f.end());
+        }
+        return out;
+    }
+
+    void benchBitConverter(std::mt19937 &rng) {
+        std::vector<unsigned char> out;
+        out.reserve(64);
+        unsigned char buf[8];
+        std::vector<unsigned char> bytes = randomBytes(rng, 16);
+        double d = 1234.5678;
+        float f = -0.1f;
+        int64_t i64 = 0x0123456789abcdefLL;
+
+        bench("BitConverter::f32_to_bytes", 4, [&] {
+            out.clear();
+            BitConverter::f32_to_bytes(f, true, out);
+            doNotOptimize(out.data());
+        });
+        bench("BitConverter::f64_to_bytes", 8, [&] {
+            out.clear();
+            BitConverter::f64_to_bytes(d, true, out);
+            doNotOptimize(out.data());
+        });
+        bench("BitConverter::i64_to_bytes", 8, [&] {
+            out.clear();
+            BitConverter::i64_to_bytes(i64, true, out);
+            doNotOptimize(out.data());
+        });
+        bench("BitConverter::bytes_to_f32", 4, [&] {
+            doNotOptimize(BitConverter::bytes_to_f32(bytes, 0, true));
+        });
+        bench("BitConverter::bytes_to_f64", 8, [&] {
+            doNotOptimize(BitConverter::bytes_to_f64(bytes, 0, true));
+        });
+        bench("BitConverter::bytes_to_i64", 8, [&] {
+            doNotOptimize(BitConverter::bytes_to_i64(bytes, 0, true));
+        });
+        bench("BitConverter::write<Big,double>", 8, [&] {
+            BitConverter::write<Endian::Big>(d, buf);
+            doNotOptimize(buf);
+        });
+        bench("BitConverter::read<double,Big>", 8, [&] {
+            doNotOptimize(BitConverter::read<double, Endian::Big>(bytes.data()));
+        });
+    }
+
+    void benchChecksum(std::mt19937 &rng) {
+        for (size_t len: {64, 1024, 65536}) {
+            std::vector<unsigned char> data = randomBytes(rng, len);
+            std::vector<unsigned char> work;
+            work.reserve(len + 2);
+            std::string suffix = "/" + std::to_string(len);
+            bench("Crc16::compute" + suffix, len, [&] {
+                doNotOptimize(Crc16::compute(data.data(), len));
+            });
+            bench("StringHex::crc16" + suffix, len, [&] {
+                work.assign(data.begin(), data.end());
+                StringHex::crc16(work, static_cast<int>(len));
+                doNotOptimize(work.data());
+            });
+            bench("IsoChecksum::compute" + suffix, len, [&] {
+                unsigned char sum[2];
+                IsoChecksum::compute(data.data(), len, sum);
+                doNotOptimize(sum);
+            });
+            bench("coderutils::ISOSum" + suffix, len, [&] {
+                work.assign(data.begin(), data.end());
+                coderutils::ISOSum(work, static_cast<int>(len), 0);
+                doNotOptimize(work.data());
+            });
+            bench("coderutils::Sum_data" + suffix, len, [&] {
+                doNotOptimize(coderutils::Sum_data(data, static_cast<int>(len)));
+            });
+        }
+    }
+
+    void benchHex(std::mt19937 &rng) {
+        for (size_t len: {64, 4096}) {
+            std::vector<unsigned char> data = randomBytes(rng, len);
+            std::string spaced = StringHex::charToHexString(data, static_cast<int>(len));
+            std::string packed = StringHex::charToHexStringWithoutSpace(data, static_cast<int>(len));
+            std::vector<char> text(len * 3);
+            std::vector<unsigned char> bytes(len);
+            std::vector<unsigned char> out;
+            out.reserve(len);
+            std::string suffix = "/" + std::to_string(len);
+            bench("HexCodec::encode" + suffix, len, [&] {
+                doNotOptimize(HexCodec::encode(data.data(), len, text.data()));
+            });
+            bench("HexCodec::encode(spaced)" + suffix, len, [&] {
+                doNotOptimize(HexCodec::encode(data.data(), len, text.data(), ' '));
+            });
+            bench("HexCodec::decode" + suffix, len, [&] {
+                doNotOptimize(HexCodec::decode(packed.data(), packed.size(), bytes.data()));
+            });
+            bench("HexCodec::decode(spaced)" + suffix, len, [&] {
+                doNotOptimize(HexCodec::decode(spaced.data(), spaced.size(), bytes.data()));
+            });
+            bench("StringHex::charToHexString" + suffix, len, [&] {
+                doNotOptimize(StringHex::charToHexString(data, static_cast<int>(len)));
+            });
+            bench("StringHex::stringToHex" + suffix, len, [&] {
+                out.clear();
+                doNotOptimize(StringHex::stringToHex(spaced, out));
+            });
+        }
+    }
+
+    void benchFrames(std::mt19937 &rng) {
+        const size_t noise_len = 4096;
+        std::vector<unsigned char> garbage = noise(rng, noise_len);
+        std::vector<unsigned char> work;
+        work.reserve(noise_len);
+        bench("coderutils::findHeaderIndex(noise)/4096", noise_len, [&] {
+            work.assign(garbage.begin(), garbage.end());
+            doNotOptimize(coderutils::findHeaderIndex(work));
+        });
+
+        FrameRingBuffer ring(noise_len);
+        bench("FrameRingBuffer::findHeader(noise)/4096", noise_len, [&] {
+            ring.push(garbage.data(), garbage.size());
+            doNotOptimize(ring.findHeader());
+        });
+
+        std::vector<unsigned char> stream = noisyStream(rng, 1024);
+        uint64_t frames = 0;
+        FrameDecoder decoder([&](const FrameView &view) {
+            frames++;
+            doNotOptimize(view.data);
+        });
+        bench("FrameDecoder::push(noisy)/" + std::to_string(stream.size()), stream.size(), [&] {
+            decoder.push(stream.data(), stream.size());
+        });
+        bench("FrameDecoder::push(noisy,64B chunks)/" + std::to_string(stream.size()), stream.size(), [&] {
+            for (size_t i = 0; i < stream.size(); i += 64) {
+                decoder.push(stream.data() + i, std::min<size_t>(64, stream.size() - i));
+            }
+        });
+
+        std::vector<unsigned char> telemetry = floatFrame(rng);
+        double sum = 0;
+        FrameDecoder floats([&](const FrameView &view) {
+            for (size_t i = 0; i < 32; i++) {
+                sum += BitConverter::read<double, Endian::Little>(view.payload() + i * 8);
+            }
+        });
+        bench("FrameDecoder::push(float frame)", telemetry.size(), [&] {
+            floats.push(telemetry.data(), telemetry.size());
+            doNotOptimize(sum);
+        });
+
+        std::vector<unsigned char> payload = randomBytes(rng, 64);
+        std::vector<unsigned char> encoded;
+        bench("coderutils::header_encode+ISOSum/64", 64, [&] {
+            encoded.clear();
+            coderutils::header_encode(64, 1, 2, 3, 4, encoded);
+            encoded.insert(encoded.end(), payload.begin(), payload.end());
+            coderutils::ISOSum(encoded, 64, 8);
+            encoded.push_back(0x09);
+            encoded.push_back(0xd7);
+            doNotOptimize(encoded.data());
+        });
+        unsigned char frame_buf[128];
+        bench("FrameEncoder::encode/64", 64, [&] {
+            doNotOptimize(FrameEncoder::encode(frame_buf, sizeof(frame_buf), payload.data(), 64, 1, 2, 3, 4));
+        });
+    }
+
+    void writeJson(FILE *out) {
+        fprintf(out, "{\n  \"seed\": %u,\n  \"results\": [\n", SEED);
+        for (size_t i = 0; i < g_results.size(); i++) {
+            const Result &r = g_results[i];
+            fprintf(out, "    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, "
+                         "\"bytes_per_sec\": %.1f, \"allocs_per_op\": %.3f}%s\n",
+                    r.name.c_str(), static_cast<unsigned long long>(r.iterations), r.ns_per_op,
+                    r.bytes_per_sec, r.allocs_per_op, i + 1 < g_results.size() ? "," : "");
+        }
+        fprintf(out, "  ]\n}\n");
+    }
+}
+
+void *operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 2) g_filter = argv[2];
+
+    std::mt19937 rng(SEED);
+    benchBitConverter(rng);
+    benchChecksum(rng);
+    benchHex(rng);
+    benchFrames(rng);
+
+    FILE *out = stdout;
+    if (argc > 1) {
+        out = fopen(argv[1], "w");
+        if (out == nullptr) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+    writeJson(out);
+    if (out != stdout) fclose(out);
+    return 0;
+}
@@ -0,0 +1,149 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: IsoChecksum 与逐字节参考实现的随机差分校验
+*
+* 编译：
+*   g++ -std=c++17 -O2 -mssse3 -I../util IsoChecksumCheck.cpp -o iso_checksum_check
+* 运行：
+*   ./iso_checksum_check [最大长度] [随机轮数]
+*
+* 对 0..最大长度 的每个长度、0..15 的每个起始偏移（覆盖非对齐加载）比较 compute/verify
+* 与参考实现的结果，并随机切分为多段 update 检查增量计算。另测若干跨 BLOCK 的长数据。
+* 不带 -mssse3 编译时只校验标量路径。不一致时打印首个差异并返回 1。
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "IsoChecksum.hpp"
+
+using namespace lanyueuav;
+
+namespace {
+    const uint32_t SEED = 20240229;
+
+    /**
+     * 逐字节累加、逐字节取模的参考实现，与原 coderutils::ISOSum 的公式一致
+     */
+    void reference(const unsigned char *data, size_t len, unsigned char *out) {
+        uint32_t c0 = 0, c1 = 0;
+        for (size_t i = 0; i < len; i++) {
+            c0 = (c0 + data[i]) % 0xff;
+            c1 = (c1 + c0) % 0xff;
+        }
+        unsigned char s0 = static_cast<unsigned char>((0xff - (c0 + c1) % 0xff) % 0xff);
+        unsigned char s1 = static_cast<unsigned char>(c1 % 0xff);
+        out[0] = s0 == 0 ? 0xff : s0;
+        out[1] = s1 == 0 ? 0xff : s1;
+    }
+
+    bool referenceValid(const unsigned char *data, size_t len) {
+        if (data[len] == 0 || data[len + 1] == 0) {
+            return false;
+        }
+        uint32_t c0 = 0, c1 = 0;
+        for (size_t i = 0; i < len + 2; i++) {
+            c0 = (c0 + data[i]) % 0xff;
+            c1 = (c1 + c0) % 0xff;
+        }
+        return c0 == 0 && c1 == 0;
+    }
+
+    /**
+     * @brief 比较一段数据的全部接口
+     * @return 一致返回 true，否则打印差异
+     */
+    bool check(std::mt19937 &rng, const unsigned char *data, size_t len, size_t offset) {
+        unsigned char expected[2], actual[2];
+        reference(data, len, expected);
+        IsoChecksum::compute(data, len, actual);
+        if (expected[0] != actual[0] || expected[1] != actual[1]) {
+            fprintf(stderr, "compute 不一致: len=%zu offset=%zu 期望 %02x %02x 实际 %02x %02x\n", len, offset,
+                    expected[0], expected[1], actual[0], actual[1]);
+            return false;
+        }
+
+        //随机切成若干段增量计算，多数段不超过 64 字节，偶尔取剩余全部
+        IsoChecksum sum;
+        size_t pos = 0;
+        while (pos < len) {
+            size_t remain = len - pos;
+            size_t limit = rng() % 4 && remain > 64 ? 64 : remain;
+            size_t n = 1 + rng() % limit;
+            sum.update(data + pos, n);
+            pos += n;
+        }
+        sum.store(actual);
+        if (expected[0] != actual[0] || expected[1] != actual[1]) {
+            fprintf(stderr, "分段 update 不一致: len=%zu offset=%zu\n", len, offset);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 在尾部追加正确或被破坏的校验码后比较 verify
+     */
+    bool checkVerify(std::mt19937 &rng, std::vector<unsigned char> &buf, size_t offset, size_t len) {
+        unsigned char *data = buf.data() + offset;
+        reference(data, len, data + len);
+        if (rng() % 2) {
+            data[rng() % (len + 2)] ^= static_cast<unsigned char>(1 + rng() % 255);
+        }
+        if (IsoChecksum::verify(data, len) != referenceValid(data, len)) {
+            fprintf(stderr, "verify 不一致: len=%zu offset=%zu\n", len, offset);
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t max_len = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1024;
+    unsigned rounds = argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : 4;
+
+#ifdef __SSSE3__
+    fprintf(stderr, "SSSE3 路径与标量参考对比\n");
+#else
+    fprintf(stderr, "未启用 SSSE3，仅校验标量路径\n");
+#endif
+
+    std::mt19937 rng(SEED);
+    //最长数据加偏移与校验码，另留出跨多个 BLOCK 的长度
+    std::vector<unsigned char> buf(max_len + IsoChecksum::BLOCK * 3 + 64);
+    uint64_t cases = 0;
+    for (unsigned round = 0; round < rounds; round++) {
+        //每轮分别使用随机数据与全 0xff（累加最快逼近溢出）
+        for (auto &b: buf) b = round % 2 ? 0xff : static_cast<unsigned char>(rng());
+        for (size_t len = 0; len <= max_len; len++) {
+            for (size_t offset = 0; offset < 16; offset++) {
+                if (!check(rng, buf.data() + offset, len, offset)) return 1;
+                cases++;
+            }
+        }
+        if (round % 2) continue;
+        for (size_t len = 1; len <= max_len; len++) {
+            size_t offset = rng() % 16;
+            std::vector<unsigned char> copy(buf);
+            if (!checkVerify(rng, copy, offset, len)) return 1;
+            cases++;
+        }
+    }
+
+    //跨 BLOCK 边界的长数据
+    const size_t long_lens[] = {IsoChecksum::BLOCK - 1, IsoChecksum::BLOCK, IsoChecksum::BLOCK + 1,
+                                IsoChecksum::BLOCK * 2 + 17, IsoChecksum::BLOCK * 3};
+    for (size_t len: long_lens) {
+        for (size_t offset = 0; offset < 16; offset++) {
+            if (!check(rng, buf.data() + offset, len, offset)) return 1;
+            cases++;
+        }
+    }
+
+    fprintf(stderr, "通过 %llu 组\n", static_cast<unsigned long long>(cases));
+    return 0;
+}
@@ -0,0 +1,441 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: ModbusMaster 与伪终端从站模拟器的联调检查
+*
+* 编译：
+*   g++ -std=c++17 -O2 -I../serial_port -I../bit_converter ModbusMasterCheck.cpp ../serial_port/ModbusMaster.cpp \
+*       ../serial_port/SerialPort.cpp ../serial_port/SerialEnumerator.cpp ../serial_port/SerialBaud.cpp \
+*       ../serial_port/SerialCapture.cpp -o modbus_master_check -lutil -lpthread
+* 运行：
+*   ./modbus_master_check
+*
+* 伪终端主端由模拟器线程按 RTU 报文应答，各从站行为：
+*   1 正常应答，应答分两次写出以检查拼帧；支持写寄存器
+*   2 地址 >= 1000 时返回异常码 02
+*   3 不应答（超时、离线跳过）
+*   4 应答 CRC 错误
+* 检查合并计划、读写结果、异常、CRC 错误、超时与离线跳过、单个请求的超时、回调中修改轮询、发送超时，
+* 以及应答结束到下一请求开始之间的静默不少于 t3.5。任一项失败返回 1。
+*/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Crc16.hpp"
+#include "ModbusMaster.h"
+
+using lanyueuav::Crc16;
+
+namespace {
+    int g_failures = 0;
+
+    void expect(bool condition, const char *what) {
+        if (!condition) {
+            fprintf(stderr, "失败: %s\n", what);
+            g_failures++;
+        }
+    }
+
+    uint64_t nowNs() {
+        return SerialPortStats::nowNs();
+    }
+
+    /**
+     * @brief 伪终端主端上的 RTU 从站
+     *
+     * 以 2 ms 无数据作为请求帧边界，与请求长度一起判定一帧结束。
+     */
+    class SlaveSimulator {
+    public:
+        explicit SlaveSimulator(int fd) : _fd(fd), _thread([this] { run(); }) {}
+
+        ~SlaveSimulator() {
+            _running = false;
+            _thread.join();
+        }
+
+        //暂停读取，使从端的发送缓冲区可以被填满
+        void pause(bool paused) {
+            _paused = paused;
+        }
+
+        int requests() const { return _requests; }
+
+        //每次应答写完到下一请求首字节到达的间隔(纳秒)
+        std::vector<uint64_t> gaps() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _gaps;
+        }
+
+        void clearGaps() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _gaps.clear();
+            _replied_at = 0;
+        }
+
+    private:
+        void run() {
+            std::vector<unsigned char> buf;
+            uint64_t first_at = 0;
+            while (_running) {
+                if (_paused) {
+                    usleep(1000);
+                    buf.clear();
+                    continue;
+                }
+                struct pollfd pfd{_fd, POLLIN, 0};
+                if (::poll(&pfd, 1, 2) <= 0) {
+                    buf.clear();
+                    continue;
+                }
+                unsigned char tmp[512];
+                ssize_t n = ::read(_fd, tmp, sizeof(tmp));
+                if (n <= 0) continue;
+                if (buf.empty()) first_at = nowNs();
+                buf.insert(buf.end(), tmp, tmp + n);
+                if (buf.size() < 8) continue;
+                size_t need = buf[1] == 0x10 ? 9 + static_cast<size_t>(buf[6]) : 8;
+                if (buf.size() < need) continue;
+                if (!Crc16::verify(buf.data(), need)) {
+                    buf.clear();
+                    continue;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_replied_at != 0) _gaps.push_back(first_at - _replied_at);
+                    _replied_at = 0;
+                }
+                _requests++;
+                handle(buf.data());
+                buf.clear();
+            }
+        }
+
+        void handle(const unsigned char *req) {
+            uint8_t slave = req[0], function = req[1];
+            uint16_t address = static_cast<uint16_t>(req[2] << 8 | req[3]);
+            uint16_t value = static_cast<uint16_t>(req[4] << 8 | req[5]);
+            if (slave == 3) {
+                return;
+            }
+            if (slave == 2 && address >= 1000) {
+                reply({slave, static_cast<unsigned char>(function | 0x80), 0x02}, false);
+                return;
+            }
+            std::vector<unsigned char> out{slave, function};
+            if (function == 0x03 || function == 0x04) {
+                out.push_back(static_cast<unsigned char>(value * 2));
+                for (uint16_t i = 0; i < value; i++) {
+                    uint16_t v = registerValue(slave, function, static_cast<uint16_t>(address + i));
+                    out.push_back(static_cast<unsigned char>(v >> 8));
+                    out.push_back(static_cast<unsigned char>(v & 0xff));
+                }
+            } else if (function == 0x06) {
+                _holding[address & 0xff] = value;
+                out.insert(out.end(), req + 2, req + 6);
+            } else if (function == 0x10) {
+                for (uint16_t i = 0; i < value; i++) {
+                    _holding[(address + i) & 0xff] = static_cast<uint16_t>(req[7 + 2 * i] << 8 | req[8 + 2 * i]);
+                }
+                out.insert(out.end(), req + 2, req + 6);
+            }
+            reply(out, slave == 4);
+        }
+
+        uint16_t registerValue(uint8_t slave, uint8_t function, uint16_t address) const {
+            if (slave == 1 && function == 0x03) {
+                return _holding[address & 0xff];
+            }
+            return static_cast<uint16_t>(address * slave);
+        }
+
+        void reply(std::vector<unsigned char> out, bool corrupt) {
+            unsigned char crc[2];
+            Crc16::store(Crc16::compute(out.data(), out.size()), crc);
+            out.push_back(crc[0]);
+            out.push_back(static_cast<unsigned char>(corrupt ? crc[1] ^ 0x5a : crc[1]));
+            //分两次写出，中间的停顿小于 t1.5 + gapSlackUs，主站应拼成一帧
+            ssize_t ret = ::write(_fd, out.data(), 3);
+            usleep(200);
+            {
+                //在写出最后一段之前记录，主站收到末字节不会早于该时间，测得的静默是实际静默的下界
+                std::lock_guard<std::mutex> lock(_mutex);
+                _replied_at = nowNs();
+            }
+            ret = ::write(_fd, out.data() + 3, out.size() - 3);
+            (void) ret;
+        }
+
+        int _fd;
+        uint16_t _holding[256] = {};
+        std::atomic<bool> _running{true};
+        std::atomic<bool> _paused{false};
+        std::atomic<int> _requests{0};
+        std::mutex _mutex;
+        uint64_t _replied_at = 0;
+        std::vector<uint64_t> _gaps;
+        std::thread _thread;
+    };
+
+    struct Outcome {
+        int calls = 0;
+        ModbusMaster::Status status = ModbusMaster::StatusOk;
+        std::vector<uint16_t> values;
+        uint8_t exception = 0;
+
+        ModbusMaster::Handler handler() {
+            return [this](ModbusMaster::Status s, const uint16_t *v, size_t count, uint8_t e) {
+                calls++;
+                status = s;
+                values.assign(v, v ? v + count : v);
+                exception = e;
+            };
+        }
+    };
+
+    //执行一次性请求直到回调完成
+    void runOnce(ModbusMaster &master, const Outcome &outcome) {
+        int calls = outcome.calls;
+        while (outcome.calls == calls && master.poll()) {}
+    }
+
+    void checkIntervals() {
+        uint64_t t15, t35;
+        ModbusMaster::silentIntervals(9600, 11 * 1000000000ull / 9600, t15, t35);
+        expect(t15 > 1700000 && t15 < 1730000, "9600 波特的 t1.5 约 1.72 ms");
+        expect(t35 > 4000000 && t35 < 4020000, "9600 波特的 t3.5 约 4.01 ms");
+        ModbusMaster::silentIntervals(115200, 11 * 1000000000ull / 115200, t15, t35);
+        expect(t15 == 750000 && t35 == 1750000, "19200 以上固定为 750/1750 us");
+    }
+
+    void checkPolls(ModbusMaster &master, SlaveSimulator &sim) {
+        int ok = 0, timeouts = 0, wrong = 0;
+        auto handler = [&](uint8_t slave, uint16_t address) {
+            return [&, slave, address](ModbusMaster::Status s, const uint16_t *v, size_t count, uint8_t) {
+                if (s == ModbusMaster::StatusTimeout) {
+                    timeouts++;
+                    return;
+                }
+                if (s != ModbusMaster::StatusOk) {
+                    wrong++;
+                    return;
+                }
+                for (size_t i = 0; i < count; i++) {
+                    if (v[i] != static_cast<uint16_t>((address + i) * slave)) wrong++;
+                }
+                ok++;
+            };
+        };
+        master.addPoll(1, ModbusMaster::ReadInputRegisters, 0, 10, handler(1, 0));
+        master.addPoll(1, ModbusMaster::ReadInputRegisters, 12, 4, handler(1, 12));     //间隔 2，合并
+        master.addPoll(1, ModbusMaster::ReadInputRegisters, 5, 3, handler(1, 5));       //重叠，合并
+        master.addPoll(1, ModbusMaster::ReadInputRegisters, 200, 2, handler(1, 200));   //相距太远，单独请求
+        master.addPoll(2, ModbusMaster::ReadInputRegisters, 0, 100, handler(2, 0));
+        master.addPoll(2, ModbusMaster::ReadInputRegisters, 100, 50, handler(2, 100));  //合并后超过 125，单独请求
+        master.addPoll(3, ModbusMaster::ReadInputRegisters, 0, 1, handler(3, 0));       //不应答
+        expect(master.plannedRequests() == 5, "7 个轮询合并为 5 个请求");
+
+        int before = sim.requests();
+        for (int c = 0; c < 10; c++) master.cycle();
+        expect(ok == 60 && wrong == 0, "每周期 6 个轮询项读到正确数据");
+        //offlineAfter = 3：前 3 个周期超时，之后离线跳过
+        expect(timeouts == 3, "离线从站只超时 offlineAfter 次");
+        expect(sim.requests() - before == 4 * 10 + 3, "离线从站的请求不再发出");
+        master.clearPolls();
+    }
+
+    //轮询项指定的超时，合并请求取其中最长的
+    void checkPollTimeout(ModbusMaster &master) {
+        int late = 0;
+        auto count_timeout = [&](ModbusMaster::Status s, const uint16_t *, size_t, uint8_t) {
+            if (s == ModbusMaster::StatusTimeout) late++;
+        };
+        master.addPoll(3, ModbusMaster::ReadInputRegisters, 0, 1, count_timeout, 10);
+        master.addPoll(3, ModbusMaster::ReadInputRegisters, 2, 1, count_timeout, 60);
+        expect(master.plannedRequests() == 1, "不同超时的相邻轮询仍然合并");
+        uint64_t start = nowNs();
+        master.cycle();
+        double elapsed_ms = (nowNs() - start) / 1e6;
+        expect(late == 2 && elapsed_ms >= 60 && elapsed_ms < 110, "合并的轮询请求使用最长的 timeoutMs");
+        master.clearPolls();
+    }
+
+    //回调中修改轮询项推迟到回调结束后生效
+    void checkReentrant(ModbusMaster &master) {
+        int first = 0, merged = 0, added = 0, index = -1;
+        auto on_added = [&](ModbusMaster::Status s, const uint16_t *, size_t, uint8_t) {
+            if (s == ModbusMaster::StatusOk) added++;
+        };
+        master.addPoll(1, ModbusMaster::ReadInputRegisters, 0, 2,
+                       [&](ModbusMaster::Status, const uint16_t *, size_t, uint8_t) {
+                           first++;
+                           master.clearPolls();
+                           index = master.addPoll(1, ModbusMaster::ReadInputRegisters, 20, 2, on_added);
+                           master.addPoll(1, ModbusMaster::ReadInputRegisters, 22, 2, on_added);
+                       });
+        master.addPoll(1, ModbusMaster::ReadInputRegisters, 2, 2,
+                       [&](ModbusMaster::Status, const uint16_t *, size_t, uint8_t) { merged++; });
+        master.addPoll(1, ModbusMaster::ReadInputRegisters, 200, 2, on_added);
+        expect(master.plannedRequests() == 2, "回调修改前的计划");
+        size_t executed = master.cycle();
+        expect(first == 1 && merged == 1, "同一请求的其余回调照常执行");
+        expect(executed == 1 && added == 0, "计划改变后本周期提前结束");
+        expect(index == 0, "回调中 addPoll 返回生效后的编号");
+        expect(master.plannedRequests() == 1, "清除后只剩回调中添加的轮询");
+        master.cycle();
+        expect(added == 2 && first == 1, "下一周期按新的计划执行");
+        master.clearPolls();
+    }
+
+    void checkErrors(ModbusMaster &master) {
+        Outcome write_single, write_multi, read_back, exception, crc, timeout;
+        uint16_t values[2] = {0x1234, 0x5678};
+        master.write(1, 7, values, 1, write_single.handler());
+        runOnce(master, write_single);
+        master.write(1, 8, values, 2, write_multi.handler());
+        runOnce(master, write_multi);
+        master.read(1, ModbusMaster::ReadHoldingRegisters, 7, 3, read_back.handler());
+        runOnce(master, read_back);
+        expect(write_single.status == ModbusMaster::StatusOk && write_multi.status == ModbusMaster::StatusOk,
+               "写单个与多个寄存器");
+        expect(read_back.status == ModbusMaster::StatusOk
+               && read_back.values == std::vector<uint16_t>({0x1234, 0x1234, 0x5678}), "读回写入的寄存器");
+
+        master.read(2, ModbusMaster::ReadHoldingRegisters, 1000, 1, exception.handler());
+        runOnce(master, exception);
+        expect(exception.status == ModbusMaster::StatusException && exception.exception == 2, "异常应答返回异常码");
+
+        uint64_t crc_errors = master.crcErrors();
+        master.read(4, ModbusMaster::ReadInputRegisters, 0, 4, crc.handler());
+        runOnce(master, crc);
+        expect(crc.status == ModbusMaster::StatusCrcError, "CRC 错误的应答");
+        expect(master.crcErrors() - crc_errors == 2, "CRC 错误按 retries 重试一次");
+
+        uint64_t start = nowNs();
+        master.read(3, ModbusMaster::ReadInputRegisters, 0, 1, timeout.handler());
+        runOnce(master, timeout);
+        double elapsed_ms = (nowNs() - start) / 1e6;
+        expect(timeout.status == ModbusMaster::StatusTimeout, "不应答的从站超时");
+        //timeoutMs = 30，重试一次
+        expect(elapsed_ms >= 60 && elapsed_ms < 150, "超时时间与 timeoutMs、retries 一致");
+
+        //单个请求指定的超时优先于 Options::timeoutMs
+        Outcome short_read, long_write;
+        start = nowNs();
+        master.read(3, ModbusMaster::ReadInputRegisters, 0, 1, short_read.handler(), 10);
+        runOnce(master, short_read);
+        elapsed_ms = (nowNs() - start) / 1e6;
+        expect(short_read.status == ModbusMaster::StatusTimeout && elapsed_ms >= 20 && elapsed_ms < 55,
+               "读请求使用自身的 timeoutMs");
+        start = nowNs();
+        master.write(3, 0, values, 1, long_write.handler(), 80);
+        runOnce(master, long_write);
+        elapsed_ms = (nowNs() - start) / 1e6;
+        expect(long_write.status == ModbusMaster::StatusTimeout && elapsed_ms >= 160 && elapsed_ms < 250,
+               "写请求使用自身的 timeoutMs");
+    }
+
+    void checkSendTimeout(ModbusMaster &master, SlaveSimulator &sim, int master_fd, const char *name) {
+        //模拟器停止读取后用另一个描述符写满从端缓冲区，之后的请求无法写出
+        sim.pause(true);
+        usleep(5000);
+        int filler = ::open(name, O_WRONLY | O_NOCTTY | O_NONBLOCK);
+        unsigned char junk[1024] = {};
+        //伪终端在后台把缓冲的数据移交给线路规程后会再腾出空间，反复写到一轮都写不进为止
+        for (bool wrote = true; wrote; usleep(5000)) {
+            wrote = false;
+            while (::write(filler, junk, sizeof(junk)) > 0) wrote = true;
+            //剩余空间不足 1024 字节时逐字节写满
+            while (::write(filler, junk, 1) > 0) wrote = true;
+        }
+        Outcome stalled;
+        uint64_t start = nowNs();
+        master.read(1, ModbusMaster::ReadInputRegisters, 0, 1, stalled.handler());
+        runOnce(master, stalled);
+        double elapsed_ms = (nowNs() - start) / 1e6;
+        expect(stalled.status == ModbusMaster::StatusPortError, "发送缓冲区写满时返回 StatusPortError");
+        expect(elapsed_ms < 100, "发送受同一截止时间约束，不会无限等待");
+        ::close(filler);
+        tcflush(master_fd, TCIFLUSH);
+        sim.pause(false);
+        usleep(5000);
+    }
+
+    void checkSilence(ModbusMaster &master, SlaveSimulator &sim) {
+        Outcome outcome;
+        sim.clearGaps();
+        for (int i = 0; i < 50; i++) {
+            master.read(1, ModbusMaster::ReadInputRegisters, static_cast<uint16_t>(i), 4, outcome.handler());
+            runOnce(master, outcome);
+        }
+        std::vector<uint64_t> gaps = sim.gaps();
+        expect(gaps.size() == 49, "记录到每次应答之后的间隔");
+        if (gaps.empty()) return;
+        std::sort(gaps.begin(), gaps.end());
+        uint64_t t35 = master.t35Ns();
+        fprintf(stderr, "应答后静默: min %.0f us, p50 %.0f us, max %.0f us, t3.5 %.0f us\n", gaps.front() / 1e3,
+                gaps[gaps.size() / 2] / 1e3, gaps.back() / 1e3, t35 / 1e3);
+        expect(gaps.front() >= t35, "应答结束到下一请求之间的静默不少于 t3.5");
+    }
+}
+
+int main() {
+    int master_fd, slave_fd;
+    char name[64];
+    if (openpty(&master_fd, &slave_fd, name, nullptr, nullptr) < 0) {
+        perror("openpty");
+        return 1;
+    }
+    struct termios tios{};
+    tcgetattr(master_fd, &tios);
+    cfmakeraw(&tios);
+    tcsetattr(master_fd, TCSANOW, &tios);
+
+    SerialPort::OpenOptions port_options = SerialPort::defaultOptions;
+    port_options.baudRate = SerialPort::BR115200;
+    port_options.vtime = 0;
+    SerialPort port(name, port_options);
+    ::close(slave_fd);
+    if (!port.isOpen()) {
+        fprintf(stderr, "打开 %s 失败\n", name);
+        return 1;
+    }
+
+    checkIntervals();
+    {
+        SlaveSimulator sim(master_fd);
+        ModbusMaster::Options options = ModbusMaster::defaultOptions;
+        options.timeoutMs = 30;
+        options.offlineRetryMs = 10000;
+        ModbusMaster master(port, options);
+        options.retries = 0;
+        ModbusMaster no_retry(port, options);
+        checkPolls(no_retry, sim);
+        options.offlineAfter = 0;
+        ModbusMaster always_poll(port, options);
+        checkPollTimeout(always_poll);
+        checkReentrant(master);
+        checkErrors(master);
+        checkSendTimeout(master, sim, master_fd, name);
+        checkSilence(master, sim);
+    }
+    port.close();
+    ::close(master_fd);
+
+    if (g_failures != 0) {
+        fprintf(stderr, "%d 项失败\n", g_failures);
+        return 1;
+    }
+    fprintf(stderr, "全部通过\n");
+    return 0;
+}
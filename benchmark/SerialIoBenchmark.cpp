@@ -0,0 +1,233 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: SerialUring 的 io_uring 与 epoll 后端对比，基于伪终端回环
+*
+* 编译：
+*   g++ -std=c++17 -O2 -I../serial_port SerialIoBenchmark.cpp ../serial_port/SerialUring.cpp \
+*       ../serial_port/SerialReactor.cpp ../serial_port/SerialPort.cpp ../serial_port/SerialEnumerator.cpp \
+*       ../serial_port/SerialBaud.cpp ../serial_port/SerialCapture.cpp -o serial_io_benchmark -lutil -lpthread
+* 运行：
+*   ./serial_io_benchmark [结果文件.json] [串口数] [每个串口的数据包数]
+*
+* 读方向：写线程向各伪终端主端轮流写入固定长度的数据包，事件循环线程从从端读取。
+* 写方向：事件循环线程每轮对每个串口调用一次 SerialUring::write，读线程从主端收取，
+* 覆盖 WRITE_FIXED、部分写续发与缓冲区满后的 POLLOUT 链式续发。
+* 输出每个数据包的 I/O 系统调用次数、每 MB 消耗的事件循环线程 CPU 时间与吞吐，结果以 JSON 输出。
+*/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SerialUring.h"
+
+namespace {
+    const size_t FRAME_SIZE = 64;
+
+    struct Result {
+        std::string backend;
+        std::string direction;
+        unsigned ports;
+        uint64_t frames;
+        double syscalls_per_frame;
+        double cpu_us_per_mb;
+        double bytes_per_sec;
+    };
+
+    std::vector<Result> g_results;
+
+    double threadCpuSeconds() {
+        struct timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<double>(ts.tv_sec) + ts.tv_nsec / 1e9;
+    }
+
+    double wallSeconds() {
+        struct timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<double>(ts.tv_sec) + ts.tv_nsec / 1e9;
+    }
+
+    /**
+     * @param forceEpoll 使用 epoll 后端
+     * @param write true 为写方向，false 为读方向
+     */
+    bool run(bool forceEpoll, bool write, unsigned ports, uint64_t frames_per_port) {
+        std::vector<int> masters;
+        std::vector<std::unique_ptr<SerialPort>> serials;
+        SerialPort::OpenOptions options = SerialPort::defaultOptions;
+        options.vtime = 0;
+        for (unsigned i = 0; i < ports; i++) {
+            int master, slave;
+            char name[64];
+            if (openpty(&master, &slave, name, nullptr, nullptr) < 0) {
+                perror("openpty");
+                return false;
+            }
+            struct termios tios{};
+            tcgetattr(master, &tios);
+            cfmakeraw(&tios);
+            tcsetattr(master, TCSANOW, &tios);
+            ::close(slave);
+            masters.push_back(master);
+            serials.emplace_back(new SerialPort(name, options));
+        }
+
+        SerialUring::Options io_options = SerialUring::defaultOptions;
+        io_options.maxPorts = ports;
+        io_options.forceEpoll = forceEpoll;
+        SerialUring io(io_options);
+        if (!io.isValid()) {
+            fprintf(stderr, "SerialUring 初始化失败\n");
+            return false;
+        }
+        const char *backend = io.backend() == SerialUring::BackendUring ? "io_uring" : "epoll";
+        if (!forceEpoll && io.backend() != SerialUring::BackendUring) {
+            fprintf(stderr, "io_uring 不可用，跳过\n");
+            return true;
+        }
+
+        const char *direction = write ? "write" : "read";
+        uint64_t total = frames_per_port * FRAME_SIZE * ports;
+        std::atomic<uint64_t> received{0};
+        for (auto &serial: serials) {
+            io.add(*serial, [&](SerialPort &, const unsigned char *, int length, uint64_t) {
+                if (length > 0) received.fetch_add(static_cast<uint64_t>(length), std::memory_order_relaxed);
+            });
+        }
+
+        unsigned char frame[FRAME_SIZE];
+        for (size_t i = 0; i < FRAME_SIZE; i++) frame[i] = static_cast<unsigned char>(i);
+        std::atomic<bool> peer_running{true};
+        std::thread peer([&] {
+            if (!write) {
+                for (uint64_t n = 0; n < frames_per_port; n++) {
+                    for (int master: masters) {
+                        ssize_t ret = ::write(master, frame, sizeof(frame));
+                        (void) ret;
+                    }
+                }
+                return;
+            }
+            //写方向：从主端收取事件循环写出的数据
+            std::vector<struct pollfd> fds;
+            for (int master: masters) {
+                fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+                fds.push_back({master, POLLIN, 0});
+            }
+            unsigned char buf[4096];
+            while (peer_running && received.load(std::memory_order_relaxed) < total) {
+                if (::poll(fds.data(), fds.size(), 100) <= 0) continue;
+                for (auto &pfd: fds) {
+                    if (!(pfd.revents & POLLIN)) continue;
+                    ssize_t n;
+                    while ((n = ::read(pfd.fd, buf, sizeof(buf))) > 0) {
+                        received.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+
+        uint64_t syscalls = io.syscalls();
+        double cpu = threadCpuSeconds();
+        double start = wallSeconds();
+        if (write) {
+            //每轮每个串口一包，一轮之后不等待地提交一次，模拟周期性下发
+            for (uint64_t n = 0; n < frames_per_port; n++) {
+                for (auto &serial: serials) io.write(*serial, frame, sizeof(frame));
+                io.runOnce(0);
+            }
+        }
+        uint64_t last = 0;
+        double last_progress = wallSeconds();
+        while (received.load(std::memory_order_relaxed) < total) {
+            io.runOnce(write ? 10 : 1000);
+            //1 秒没有任何进展视为卡住
+            uint64_t now_received = received.load(std::memory_order_relaxed);
+            if (now_received != last) {
+                last = now_received;
+                last_progress = wallSeconds();
+            } else if (wallSeconds() - last_progress > 1.0) {
+                break;
+            }
+        }
+        double elapsed = wallSeconds() - start;
+        cpu = threadCpuSeconds() - cpu;
+        syscalls = io.syscalls() - syscalls;
+        uint64_t done = received.load(std::memory_order_relaxed);
+        peer_running = false;
+        if (done < total) {
+            fprintf(stderr, "%s %s: 只收到 %llu/%llu 字节\n", backend, direction, static_cast<unsigned long long>(done),
+                    static_cast<unsigned long long>(total));
+            for (int master: masters) ::close(master);
+            peer.join();
+            return false;
+        }
+        peer.join();
+
+        uint64_t frames = frames_per_port * ports;
+        Result result{backend, direction, ports, frames, static_cast<double>(syscalls) / frames,
+                      cpu * 1e6 / (done / 1e6), done / elapsed};
+        fprintf(stderr, "%-10s %-5s ports=%-3u %10.3f syscalls/frame %10.1f us CPU/MB %10.2f MB/s\n",
+                backend, direction, ports, result.syscalls_per_frame, result.cpu_us_per_mb,
+                result.bytes_per_sec / 1e6);
+        g_results.push_back(result);
+
+        for (auto &serial: serials) {
+            io.remove(*serial);
+            serial->close();
+        }
+        for (int master: masters) ::close(master);
+        return true;
+    }
+
+    void writeJson(FILE *out) {
+        fprintf(out, "{\n  \"frame_size\": %zu,\n  \"results\": [\n", FRAME_SIZE);
+        for (size_t i = 0; i < g_results.size(); i++) {
+            const Result &r = g_results[i];
+            fprintf(out, "    {\"backend\": \"%s\", \"direction\": \"%s\", \"ports\": %u, \"frames\": %llu, "
+                         "\"syscalls_per_frame\": %.4f, \"cpu_us_per_mb\": %.1f, \"bytes_per_sec\": %.1f}%s\n",
+                    r.backend.c_str(), r.direction.c_str(), r.ports, static_cast<unsigned long long>(r.frames), r.syscalls_per_frame,
+                    r.cpu_us_per_mb, r.bytes_per_sec, i + 1 < g_results.size() ? "," : "");
+        }
+        fprintf(out, "  ]\n}\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    unsigned ports = argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : 8;
+    uint64_t frames = argc > 3 ? strtoull(argv[3], nullptr, 10) : 20000;
+    if (ports == 0 || frames == 0) {
+        fprintf(stderr, "串口数与数据包数需大于 0\n");
+        return 1;
+    }
+
+    for (bool write: {false, true}) {
+        if (!run(true, write, ports, frames) || !run(false, write, ports, frames)) {
+            return 1;
+        }
+    }
+
+    FILE *out = stdout;
+    if (argc > 1) {
+        out = fopen(argv[1], "w");
+        if (out == nullptr) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+    writeJson(out);
+    if (out != stdout) fclose(out);
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: SerialPort 延迟配置的往返延迟测试，基于伪终端回环
+*
+* 编译：
+*   g++ -std=c++17 -O2 -I../serial_port SerialLatencyBenchmark.cpp ../serial_port/SerialPort.cpp \
+*       ../serial_port/SerialEnumerator.cpp ../serial_port/SerialBaud.cpp ../serial_port/SerialCapture.cpp \
+*       -o serial_latency_benchmark -lutil -lpthread
+* 运行：
+*   ./serial_latency_benchmark [结果文件.json] [往返次数] [数据包长度]
+*
+* 伪终端主端由应答线程原样回送收到的数据包，模拟设备。主线程按 400 Hz 控制周期
+* 写出请求后等待应答，分别记录首字节延迟（写出到第一次 read 读到数据）与整包往返延迟。
+* 对比三种配置：默认配置 + poll 等待、LatencyLow + poll 等待、LatencyLow + busyPollUs 自旋读。
+* 另以 frameSize 为数据包长度、实际收发约 1.5 倍长的数据包，应答分两次写出，检查不足
+* frameSize 的尾部能及时唤醒 poll，不必等下一包到达。
+* 伪终端没有 UART 的 FIFO 与 USB 轮询，测得的是 tty 层与调度带来的那部分延迟。
+*/
+
+#include <poll.h>
+#include <pty.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SerialPort.h"
+
+namespace {
+    const uint64_t PERIOD_NS = 2500000;     //400 Hz 控制周期
+    const int BUSY_POLL_US = 2000;
+
+    struct Config {
+        const char *name;
+        SerialPort::LatencyProfile latency;
+        int busyPollUs;
+        bool longFrame;     //实际数据包比 frameSize 长一半，检查尾部不被滞留
+    };
+
+    struct Result {
+        std::string name;
+        int length;
+        size_t samples;
+        double first_p50_us;
+        double first_p99_us;
+        double first_max_us;
+        double rtt_p50_us;
+        double rtt_p99_us;
+        double rtt_max_us;
+        uint64_t wakeups;   //每次往返调用 poll 的次数之和
+    };
+
+    std::vector<Result> g_results;
+
+    uint64_t nowNs() {
+        struct timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    double percentileUs(std::vector<uint64_t> &samples, double p) {
+        std::sort(samples.begin(), samples.end());
+        size_t index = static_cast<size_t>(p * (samples.size() - 1) + 0.5);
+        return samples[index] / 1e3;
+    }
+
+    /**
+     * @brief 读到 length 字节为止，读不到数据时用 poll 等待
+     * @param first_ns 第一次读到数据的时间
+     * @param wakeups 累计 poll 次数
+     */
+    bool readFrame(SerialPort &port, unsigned char *data, int length, uint64_t &first_ns, uint64_t &wakeups) {
+        int got = 0;
+        first_ns = 0;
+        while (got < length) {
+            int n = port.read(data + got, length - got);
+            if (n > 0) {
+                if (got == 0) first_ns = nowNs();
+                got += n;
+                continue;
+            }
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                return false;
+            }
+            struct pollfd pfd{port.fd(), POLLIN, 0};
+            wakeups++;
+            if (::poll(&pfd, 1, 1000) <= 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool run(const Config &config, size_t rounds, int frame_size) {
+        //frameSize 始终为命令行给出的长度，longFrame 时实际收发更长的数据包
+        int length = config.longFrame ? frame_size + frame_size / 2 + 1 : frame_size;
+        int master, slave;
+        char name[64];
+        if (openpty(&master, &slave, name, nullptr, nullptr) < 0) {
+            perror("openpty");
+            return false;
+        }
+        struct termios tios{};
+        tcgetattr(master, &tios);
+        cfmakeraw(&tios);
+        tcsetattr(master, TCSANOW, &tios);
+        ::close(slave);
+
+        SerialPort::OpenOptions options = SerialPort::defaultOptions;
+        options.latency = config.latency;
+        options.frameSize = frame_size;
+        options.busyPollUs = config.busyPollUs;
+        SerialPort port(name, options);
+        if (!port.isOpen()) {
+            fprintf(stderr, "%s: 打开 %s 失败\n", config.name, name);
+            ::close(master);
+            return false;
+        }
+
+        //应答线程：收满一包后原样回送
+        std::atomic<bool> running{true};
+        std::thread device([&] {
+            std::vector<unsigned char> frame(static_cast<size_t>(length));
+            while (running) {
+                int got = 0;
+                while (got < length) {
+                    ssize_t n = ::read(master, frame.data() + got, static_cast<size_t>(length - got));
+                    if (n <= 0) return;
+                    got += static_cast<int>(n);
+                }
+                size_t sent = 0;
+                if (config.longFrame) {
+                    //先写出 frameSize 字节，尾部单独到达
+                    sent = static_cast<size_t>(frame_size);
+                    ssize_t ret = ::write(master, frame.data(), sent);
+                    (void) ret;
+                    usleep(200);
+                }
+                ssize_t ret = ::write(master, frame.data() + sent, frame.size() - sent);
+                (void) ret;
+            }
+        });
+
+        std::vector<unsigned char> request(static_cast<size_t>(length)), response(request.size());
+        std::vector<uint64_t> first, rtt;
+        uint64_t wakeups = 0;
+        bool ok = true;
+        uint64_t next = nowNs();
+        for (size_t i = 0; i < rounds + rounds / 10 && ok; i++) {
+            //按控制周期对齐，与实际控制回路一样每次都从空闲开始等待
+            next += PERIOD_NS;
+            struct timespec ts{static_cast<time_t>(next / 1000000000ull), static_cast<long>(next % 1000000000ull)};
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+
+            for (size_t k = 0; k < request.size(); k++) request[k] = static_cast<unsigned char>(i + k);
+            uint64_t start = nowNs();
+            if (port.write(request.data(), length) != length) {
+                ok = false;
+                break;
+            }
+            uint64_t first_ns;
+            uint64_t round_wakeups = 0;
+            ok = readFrame(port, response.data(), length, first_ns, round_wakeups) && response == request;
+            //前 10% 作为预热不计入
+            if (i >= rounds / 10) {
+                first.push_back(first_ns - start);
+                rtt.push_back(nowNs() - start);
+                wakeups += round_wakeups;
+            }
+        }
+
+        running = false;
+        port.close();
+        ::close(master);
+        device.join();
+        if (!ok) {
+            fprintf(stderr, "%s: 往返失败或应答不一致\n", config.name);
+            return false;
+        }
+
+        Result result{config.name, length, first.size(),
+                      percentileUs(first, 0.5), percentileUs(first, 0.99), percentileUs(first, 1.0),
+                      percentileUs(rtt, 0.5), percentileUs(rtt, 0.99), percentileUs(rtt, 1.0), wakeups};
+        fprintf(stderr, "%-22s first p50 %8.1f p99 %8.1f max %8.1f us | rtt p50 %8.1f p99 %8.1f max %8.1f us"
+                        " | %.2f poll/rtt\n",
+                config.name, result.first_p50_us, result.first_p99_us, result.first_max_us, result.rtt_p50_us,
+                result.rtt_p99_us, result.rtt_max_us, static_cast<double>(wakeups) / result.samples);
+        g_results.push_back(result);
+        return true;
+    }
+
+    void writeJson(FILE *out, int frame_size) {
+        fprintf(out, "{\n  \"frame_size\": %d,\n  \"period_us\": %llu,\n  \"results\": [\n", frame_size,
+                static_cast<unsigned long long>(PERIOD_NS / 1000));
+        for (size_t i = 0; i < g_results.size(); i++) {
+            const Result &r = g_results[i];
+            fprintf(out, "    {\"config\": \"%s\", \"length\": %d, \"samples\": %zu, \"first_p50_us\": %.1f, \"first_p99_us\": %.1f, "
+                         "\"first_max_us\": %.1f, \"rtt_p50_us\": %.1f, \"rtt_p99_us\": %.1f, \"rtt_max_us\": %.1f, "
+                         "\"polls_per_rtt\": %.3f}%s\n",
+                    r.name.c_str(), r.length, r.samples, r.first_p50_us, r.first_p99_us, r.first_max_us, r.rtt_p50_us,
+                    r.rtt_p99_us, r.rtt_max_us, static_cast<double>(r.wakeups) / r.samples,
+                    i + 1 < g_results.size() ? "," : "");
+        }
+        fprintf(out, "  ]\n}\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t rounds = argc > 2 ? strtoull(argv[2], nullptr, 10) : 2000;
+    int frame_size = argc > 3 ? atoi(argv[3]) : 16;
+    if (rounds == 0 || frame_size <= 0 || frame_size > 255) {
+        fprintf(stderr, "往返次数需大于 0，数据包长度需在 1~255\n");
+        return 1;
+    }
+
+    const Config configs[] = {
+            {"default+poll",    SerialPort::LatencyDefault, 0,            false},
+            {"low_latency+poll", SerialPort::LatencyLow,    0,            false},
+            {"low_latency+busy", SerialPort::LatencyLow,    BUSY_POLL_US, false},
+            {"low_latency+long",  SerialPort::LatencyLow,    0,            true},
+    };
+    for (const Config &config: configs) {
+        if (!run(config, rounds, frame_size)) {
+            return 1;
+        }
+    }
+
+    FILE *out = stdout;
+    if (argc > 1) {
+        out = fopen(argv[1], "w");
+        if (out == nullptr) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+    writeJson(out, frame_size);
+    if (out != stdout) fclose(out);
+    return 0;
+}
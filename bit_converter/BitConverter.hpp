@@ -9,19 +9,185 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <vector>
 
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace lanyueuav {
+    /**
+     * @brief 字节序
+     */
+    enum class Endian {
+        Little,
+        Big,
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        Native = Big
+#else
+        Native = Little
+#endif
+    };
+
+    namespace detail {
+        template<size_t N>
+        struct UInt;
+
+        template<>
+        struct UInt<1> {
+            using type = uint8_t;
+        };
+
+        template<>
+        struct UInt<2> {
+            using type = uint16_t;
+        };
+
+        template<>
+        struct UInt<4> {
+            using type = uint32_t;
+        };
+
+        template<>
+        struct UInt<8> {
+            using type = uint64_t;
+        };
+    }
+
     class BitConverter {
     public:
-        static bool i16_to_bytes(short value, bool is_big_endian, std::vector<unsigned char> &out) {
+        static inline uint8_t byteswap(uint8_t value) { return value; }
+
+        static inline uint16_t byteswap(uint16_t value) { return __builtin_bswap16(value); }
+
+        static inline uint32_t byteswap(uint32_t value) { return __builtin_bswap32(value); }
+
+        static inline uint64_t byteswap(uint64_t value) { return __builtin_bswap64(value); }
+
+        /**
+         * @brief 按指定字节序将 value 写入 out[0..sizeof(T))
+         * @tparam E 字节序
+         * @tparam T 整型或浮点类型
+         * @param value 值
+         * @param out 输出缓冲，由调用者保证空间
+         */
+        template<Endian E, typename T>
+        static inline void write(T value, unsigned char *out) {
+            static_assert(std::is_arithmetic<T>::value, "BitConverter::write requires an arithmetic type");
+            using U = typename detail::UInt<sizeof(T)>::type;
+            U bits;
+            memcpy(&bits, &value, sizeof(T));
+            if (E != Endian::Native) bits = byteswap(bits);
+            memcpy(out, &bits, sizeof(T));
+        }
+
+        /**
+         * @brief 按指定字节序从 in[0..sizeof(T)) 读取值
+         * @tparam T 整型或浮点类型
+         * @tparam E 字节序
+         * @param in 输入缓冲
+         * @return
+         */
+        template<typename T, Endian E>
+        static inline T read(const unsigned char *in) {
+            static_assert(std::is_arithmetic<T>::value, "BitConverter::read requires an arithmetic type");
+            using U = typename detail::UInt<sizeof(T)>::type;
+            U bits;
+            memcpy(&bits, in, sizeof(T));
+            if (E != Endian::Native) bits = byteswap(bits);
+            T value;
+            memcpy(&value, &bits, sizeof(T));
+            return value;
+        }
+
+        template<typename T>
+        static inline void write(T value, bool is_big_endian, unsigned char *out) {
             if (is_big_endian) {
-                out.push_back(value >> 8);
-                out.push_back(value & 0xFF);
+                write<Endian::Big>(value, out);
+            } else {
+                write<Endian::Little>(value, out);
+            }
+        }
+
+        template<typename T>
+        static inline T read(const unsigned char *in, bool is_big_endian) {
+            return is_big_endian ? read<T, Endian::Big>(in) : read<T, Endian::Little>(in);
+        }
+
+        /**
+         * @brief 批量写入：将 count 个主机序的值按指定字节序写入 out
+         * @tparam E 字节序
+         * @param in 数组
+         * @param count 元素个数
+         * @param out 输出，至少 count * sizeof(T) 字节
+         */
+        template<Endian E, typename T>
+        static inline void write_array(const T *in, size_t count, unsigned char *out) {
+            static_assert(std::is_arithmetic<T>::value, "BitConverter::write_array requires an arithmetic type");
+            if constexpr (E == Endian::Native || sizeof(T) == 1) {
+                memcpy(out, in, count * sizeof(T));
             } else {
-                out.push_back(value & 0xFF);
-                out.push_back(value >> 8);
+                swap_array<sizeof(T)>(reinterpret_cast<const unsigned char *>(in), count, out);
             }
+        }
+
+        /**
+         * @brief 批量读取：从 in 中按指定字节序读出 count 个值
+         * @tparam E 字节序
+         * @param in 输入，至少 count * sizeof(T) 字节
+         * @param out 数组
+         * @param count 元素个数
+         */
+        template<typename T, Endian E>
+        static inline void read_array(const unsigned char *in, T *out, size_t count) {
+            static_assert(std::is_arithmetic<T>::value, "BitConverter::read_array requires an arithmetic type");
+            if constexpr (E == Endian::Native || sizeof(T) == 1) {
+                memcpy(out, in, count * sizeof(T));
+            } else {
+                swap_array<sizeof(T)>(in, count, reinterpret_cast<unsigned char *>(out));
+            }
+        }
+
+        /**
+         * @brief 逐元素翻转字节序，in 与 out 可以相同
+         * @tparam N 元素字节数 2/4/8
+         */
+        template<size_t N>
+        static inline void swap_array(const unsigned char *in, size_t count, unsigned char *out) {
+            static_assert(N == 2 || N == 4 || N == 8, "BitConverter::swap_array supports 2, 4 and 8 byte elements");
+            size_t bytes = count * N;
+            size_t i = 0;
+#ifdef __AVX2__
+            {
+                const __m256i mask = _mm256_broadcastsi128_si256(swap_mask<N>());
+                for (; i + 32 <= bytes; i += 32) {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_shuffle_epi8(x, mask));
+                }
+            }
+#endif
+#ifdef __SSSE3__
+            {
+                const __m128i mask = swap_mask<N>();
+                for (; i + 16 <= bytes; i += 16) {
+                    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_shuffle_epi8(x, mask));
+                }
+            }
+#endif
+            using U = typename detail::UInt<N>::type;
+            for (; i < bytes; i += N) {
+                U value;
+                memcpy(&value, in + i, N);
+                value = byteswap(value);
+                memcpy(out + i, &value, N);
+            }
+        }
+
+        static bool i16_to_bytes(short value, bool is_big_endian, std::vector<unsigned char> &out) {
+            append(value, is_big_endian, out);
             return true;
         }
 
@@ -30,15 +196,7 @@ namespace lanyueuav {
         }
 
         static void i32_to_bytes(int32_t value, bool is_big_endian, std::vector<unsigned char> &out) {
-            if (is_big_endian) {
-                for (int i = 0; i < static_cast<int>(sizeof(int32_t)); i++) {
-                    out.push_back(static_cast<uint8_t>((value >> (24 - i * 8)) & 0xFF));
-                }
-            } else {
-                for (int i = static_cast<int>(sizeof(int32_t)) - 1; i >= 0; i--) {
-                    out.push_back(static_cast<uint8_t>((value >> (24 - i * 8)) & 0xFF));
-                }
-            }
+            append(value, is_big_endian, out);
         }
 
         static void u32_to_bytes(uint32_t value, bool is_big_endian, std::vector<unsigned char> &out) {
@@ -46,15 +204,7 @@ namespace lanyueuav {
         }
 
         static void i64_to_bytes(int64_t value, bool is_big_endian, std::vector<unsigned char> &out) {
-            if (is_big_endian) {
-                for (int i = 0; i < static_cast<int>(sizeof(int64_t)); i++) {
-                    out.push_back(static_cast<uint8_t>((value >> (56 - i * 8)) & 0xFF));
-                }
-            } else {
-                for (int i = static_cast<int>(sizeof(int64_t)) - 1; i >= 0; i--) {
-                    out.push_back(static_cast<uint8_t>((value >> (56 - i * 8)) & 0xFF));
-                }
-            }
+            append(value, is_big_endian, out);
         }
 
         static void u64_to_bytes(uint64_t value, bool is_big_endian, std::vector<unsigned char> &out) {
@@ -71,82 +221,19 @@ namespace lanyueuav {
             }
         }
 
+        /**
+         * IEEE 754 单精度按位拷贝，NaN/Inf/非规格化数原样保留
+         */
         static void f32_to_bytes(float_t value, bool is_big_endian, std::vector<unsigned char> &out) {
-            std::vector<bool> bits;
-            bits.reserve(sizeof(float_t) * 8);
-            bits.push_back(value < 0);
-
-            int exponent;
-            float_t mantissa = std::frexp(value, &exponent);
-            exponent = (exponent - 1) + 127;
-
-            for (int i = 0; i < 8; i++) {
-                bits.push_back(exponent % 2);
-                exponent = exponent / 2;
-            }
-            std::reverse(bits.begin() + 1, bits.begin() + 1 + 8);
-            mantissa = mantissa * 2 - 1;
-            for (int i = 0; i < 23; i++) {
-                mantissa = mantissa * 2;
-                if (mantissa >= 1.0) {
-                    mantissa = mantissa - 1.0;
-                    bits.push_back(true);
-                } else {
-                    bits.push_back(false);
-                }
-            }
-            if (is_big_endian) {
-                return create_bytes_from_bits(bits, out);
-            } else {
-                std::reverse(bits.begin(), bits.end());
-                return create_bytes_from_bits(bits, out);
-            }
+            append(static_cast<float>(value), is_big_endian, out);
         }
 
-
         static void f64_to_bytes(double_t value, bool is_big_endian, std::vector<unsigned char> &out) {
-            std::vector<bool> bits;
-            bits.reserve(sizeof(double_t) * 8);
-            bits.push_back(value < 0);
-
-            int exponent;
-            double_t mantissa = std::frexp(value, &exponent);
-            exponent = (exponent - 1) + 1023;
-
-            for (int i = 0; i < 11; i++) {
-                bits.push_back(exponent % 2);
-                exponent = exponent / 2;
-            }
-            std::reverse(bits.begin() + 1, bits.begin() + 1 + 11);
-            mantissa = mantissa * 2 - 1;
-            for (int i = 0; i < 52; i++) {
-                mantissa = mantissa * 2;
-                if (mantissa >= 1.0) {
-                    mantissa = mantissa - 1.0;
-                    bits.push_back(true);
-                } else {
-                    bits.push_back(false);
-                }
-            }
-            if (is_big_endian) {
-                return create_bytes_from_bits(bits, out);
-            } else {
-                std::reverse(bits.begin(), bits.end());
-                return create_bytes_from_bits(bits, out);
-            }
+            append(static_cast<double>(value), is_big_endian, out);
         }
 
         static short bytes_to_i16(const std::vector<unsigned char> &input_it, int startIndex, bool is_big_endian) {
-            short result;
-            if (is_big_endian) {
-                result = input_it[startIndex];
-                result = (result << 8) + input_it[startIndex + 1];
-                return result;
-            } else {
-                result = input_it[startIndex];
-                result = result + (input_it[startIndex + 1] << 8);
-                return result;
-            }
+            return read<short>(input_it.data() + startIndex, is_big_endian);
         }
 
 
@@ -157,18 +244,7 @@ namespace lanyueuav {
 
 
         static int bytes_to_i32(const std::vector<unsigned char> &input_it, int startIndex, bool is_big_endian) {
-            int32_t result = 0;
-            if (is_big_endian) {
-                for (int i = 0; i < 4; i++) {
-                    result = result + (input_it[startIndex + i] << (8 * (4 - 1 - i)));
-                }
-                return result;
-            } else {
-                for (int i = 0; i < 4; i++) {
-                    result = result + (input_it[startIndex + i] << (8 * i));
-                }
-                return result;
-            }
+            return read<int32_t>(input_it.data() + startIndex, is_big_endian);
         }
 
         static unsigned int
@@ -177,18 +253,7 @@ namespace lanyueuav {
         }
 
         static long bytes_to_i64(const std::vector<unsigned char> &input_it, int startIndex, bool is_big_endian) {
-            int64_t result = 0;
-            if (is_big_endian) {
-                for (int i = 0; i < 8; i++) {
-                    result = result + (input_it[startIndex + i] << (8 * (8 - 1 - i)));
-                }
-                return result;
-            } else {
-                for (int i = 0; i < 8; i++) {
-                    result = result + (input_it[startIndex + i] << (8 * i));
-                }
-                return result;
-            }
+            return static_cast<long>(read<int64_t>(input_it.data() + startIndex, is_big_endian));
         }
 
         static unsigned long
@@ -197,59 +262,28 @@ namespace lanyueuav {
         }
 
         static float bytes_to_f32(const std::vector<unsigned char> &input_it, int startIndex, bool is_big_endian) {
-            std::vector<bool> bits;
-            bits.reserve(sizeof(float_t) * 8);
-            for (int i = 0; i < static_cast<int>(sizeof(float_t)); i++) {
-                uint8_t b = input_it[startIndex + i];
-                for (int j = 0; j < 8; j++) {
-                    bits.push_back(b % 2);
-                    b = b / 2;
-                }
-            }
-            if (!is_big_endian) {
-                std::reverse(bits.begin(), bits.end());
-            }
-            int sign = bits[0] ? (-1) : (+1);
-            int exponent = 0;
-            for (int i = 0; i < 8; i++) {
-                exponent = exponent + bits[1 + i] * (1 << (8 - 1 - i));
-            }
-            exponent = exponent - 127;
-            float_t mantissa = 1.0;
-            float_t cur = 0.5;
-            for (int i = 0; i < 23; i++) {
-                mantissa = mantissa + bits[1 + 8 + i] * cur;
-                cur = cur / 2;
-            }
-            return sign * std::ldexp(mantissa, exponent);
+            return read<float>(input_it.data() + startIndex, is_big_endian);
         }
 
         static double bytes_to_f64(const std::vector<unsigned char> &input_it, int startIndex, bool is_big_endian) {
-            std::vector<bool> bits;
-            bits.reserve(sizeof(double_t) * 8);
-            for (int i = 0; i < static_cast<int>(sizeof(double_t)); i++) {
-                uint8_t b = input_it[startIndex + i];
-                for (int j = 0; j < 8; j++) {
-                    bits.push_back(b % 2);
-                    b = b / 2;
-                }
-            }
-            if (!is_big_endian) {
-                std::reverse(bits.begin(), bits.end());
-            }
-            int sign = bits[0] ? (-1) : (+1);
-            int exponent = 0;
-            for (int i = 0; i < 11; i++) {
-                exponent = exponent + bits[1 + i] * (1 << (11 - 1 - i));
-            }
-            exponent = exponent - 1023;
-            double_t mantissa = 1.0;
-            double_t cur = 0.5;
-            for (int i = 0; i < 52; i++) {
-                mantissa = mantissa + bits[1 + 11 + i] * cur;
-                cur = cur / 2;
-            }
-            return sign * std::ldexp(mantissa, exponent);
+            return read<double>(input_it.data() + startIndex, is_big_endian);
+        }
+
+    private:
+#ifdef __SSSE3__
+        template<size_t N>
+        static inline __m128i swap_mask() {
+            if (N == 2) return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+            if (N == 4) return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+            return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        }
+#endif
+
+        template<typename T>
+        static inline void append(T value, bool is_big_endian, std::vector<unsigned char> &out) {
+            unsigned char bytes[sizeof(T)];
+            write(value, is_big_endian, bytes);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
         }
     };
 }
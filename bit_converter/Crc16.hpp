@@ -0,0 +1,127 @@
+//
+// @Author: MorningXu
+// @Description: CRC16 (Modbus, 多项式 0xA001) 查表与 slicing-by-8 计算
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace lanyueuav {
+    namespace detail {
+        using Crc16Table = std::array<std::array<uint16_t, 256>, 8>;
+
+        /**
+         * @brief 编译期生成 slicing-by-8 查表，t[k][i] 为字节 i 之后再经过 k 个零字节的余数
+         */
+        constexpr Crc16Table makeCrc16Table(uint16_t polynomial) {
+            Crc16Table t{};
+            for (uint32_t i = 0; i < 256; i++) {
+                uint16_t crc = static_cast<uint16_t>(i);
+                for (int j = 0; j < 8; j++) {
+                    crc = (crc & 0x0001) ? static_cast<uint16_t>((crc >> 1) ^ polynomial)
+                                         : static_cast<uint16_t>(crc >> 1);
+                }
+                t[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; i++) {
+                for (int k = 1; k < 8; k++) {
+                    uint16_t prev = t[k - 1][i];
+                    t[k][i] = static_cast<uint16_t>((prev >> 8) ^ t[0][prev & 0xff]);
+                }
+            }
+            return t;
+        }
+    }
+
+    /**
+     * @brief CRC16-Modbus 计算，支持增量 update/finalize
+     *
+     * 8 张查表在编译期生成；长数据按 8 字节一组走 slicing-by-8，尾部逐字节查表。
+     */
+    class Crc16 {
+    public:
+        static constexpr uint16_t POLYNOMIAL = 0xa001;
+        static constexpr uint16_t INIT = 0xffff;
+
+        using Table = detail::Crc16Table;
+
+        Crc16() = default;
+
+        void reset() { _crc = INIT; }
+
+        /**
+         * @brief 追加数据
+         * @param data 数据
+         * @param len 数据长度
+         */
+        void update(const unsigned char *data, size_t len) {
+            _crc = update(_crc, data, len);
+        }
+
+        /**
+         * @return 当前 CRC 值，发送时低字节在前
+         */
+        uint16_t finalize() const { return _crc; }
+
+        /**
+         * @brief 计算整段数据的 CRC
+         */
+        static uint16_t compute(const unsigned char *data, size_t len) {
+            return update(INIT, data, len);
+        }
+
+        /**
+         * @brief 校验以 CRC（低字节在前）结尾的数据，不修改缓冲区
+         * @param data 数据，包含末尾两字节 CRC
+         * @param len 数据长度
+         * @return
+         */
+        static bool verify(const unsigned char *data, size_t len) {
+            if (len < 2) {
+                return false;
+            }
+            //包含 CRC 本身计算的余数为 0
+            return update(INIT, data, len) == 0;
+        }
+
+        /**
+         * @brief 将 CRC 按低字节在前写入 out[0..1]
+         */
+        static void store(uint16_t crc, unsigned char *out) {
+            out[0] = static_cast<unsigned char>(crc & 0x00ff);
+            out[1] = static_cast<unsigned char>(crc >> 8);
+        }
+
+        static uint16_t update(uint16_t crc, const unsigned char *data, size_t len) {
+            const Table &t = TABLE;
+            while (len >= 8) {
+                uint64_t word;
+                memcpy(&word, data, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                word = __builtin_bswap64(word);
+#endif
+                word ^= crc;
+                crc = t[7][word & 0xff] ^ t[6][(word >> 8) & 0xff]
+                      ^ t[5][(word >> 16) & 0xff] ^ t[4][(word >> 24) & 0xff]
+                      ^ t[3][(word >> 32) & 0xff] ^ t[2][(word >> 40) & 0xff]
+                      ^ t[1][(word >> 48) & 0xff] ^ t[0][word >> 56];
+                data += 8;
+                len -= 8;
+            }
+            while (len--) {
+                crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xff];
+            }
+            return crc;
+        }
+
+    private:
+        static constexpr Table TABLE = detail::makeCrc16Table(POLYNOMIAL);
+
+        uint16_t _crc = INIT;
+    };
+}
@@ -0,0 +1,154 @@
+//
+// @Author: MorningXu
+// @Description: CRC32C (Castagnoli, 多项式 0x82F63B78) 计算，支持 SSE4.2 硬件指令
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+
+namespace lanyueuav {
+    namespace detail {
+        using Crc32Table = std::array<std::array<uint32_t, 256>, 8>;
+
+        /**
+         * @brief 编译期生成 slicing-by-8 查表，t[k][i] 为字节 i 之后再经过 k 个零字节的余数
+         */
+        constexpr Crc32Table makeCrc32Table(uint32_t polynomial) {
+            Crc32Table t{};
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t crc = i;
+                for (int j = 0; j < 8; j++) {
+                    crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+                }
+                t[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; i++) {
+                for (int k = 1; k < 8; k++) {
+                    uint32_t prev = t[k - 1][i];
+                    t[k][i] = (prev >> 8) ^ t[0][prev & 0xff];
+                }
+            }
+            return t;
+        }
+    }
+
+    /**
+     * @brief CRC32C 计算，支持增量 update/finalize
+     *
+     * 编译时开启 SSE4.2 时使用 crc32 指令每次处理 8 字节，否则走 slicing-by-8 查表。
+     */
+    class Crc32c {
+    public:
+        static constexpr uint32_t POLYNOMIAL = 0x82f63b78;
+        static constexpr uint32_t INIT = 0xffffffff;
+
+        using Table = detail::Crc32Table;
+
+        Crc32c() = default;
+
+        void reset() { _crc = INIT; }
+
+        /**
+         * @brief 追加数据
+         * @param data 数据
+         * @param len 数据长度
+         */
+        void update(const unsigned char *data, size_t len) {
+            _crc = update(_crc, data, len);
+        }
+
+        /**
+         * @return 当前 CRC（已取反），可继续 update
+         */
+        uint32_t finalize() const { return ~_crc; }
+
+        /**
+         * @brief 一次性计算
+         */
+        static uint32_t compute(const unsigned char *data, size_t len) {
+            return ~update(INIT, data, len);
+        }
+
+        /**
+         * @brief 按小端写入 4 字节
+         */
+        static void store(uint32_t crc, unsigned char *out) {
+            out[0] = static_cast<unsigned char>(crc);
+            out[1] = static_cast<unsigned char>(crc >> 8);
+            out[2] = static_cast<unsigned char>(crc >> 16);
+            out[3] = static_cast<unsigned char>(crc >> 24);
+        }
+
+        /**
+         * @brief 读取 store 写入的 4 字节
+         */
+        static uint32_t load(const unsigned char *in) {
+            return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8)
+                   | (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+        }
+
+        /**
+         * @brief 校验数据后紧跟的 4 字节 CRC
+         * @param data 数据
+         * @param len 数据长度（不含 CRC）
+         */
+        static bool verify(const unsigned char *data, size_t len) {
+            return compute(data, len) == load(data + len);
+        }
+
+        /**
+         * @brief 未取反的原始更新
+         */
+        static uint32_t update(uint32_t crc, const unsigned char *data, size_t len) {
+#if defined(__SSE4_2__) && defined(__x86_64__)
+            uint64_t crc64 = crc;
+            while (len >= 8) {
+                uint64_t word;
+                memcpy(&word, data, sizeof(word));
+                crc64 = _mm_crc32_u64(crc64, word);
+                data += 8;
+                len -= 8;
+            }
+            crc = static_cast<uint32_t>(crc64);
+            while (len--) {
+                crc = _mm_crc32_u8(crc, *data++);
+            }
+            return crc;
+#else
+            const Table &t = TABLE;
+            while (len >= 8) {
+                uint64_t word;
+                memcpy(&word, data, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                word = __builtin_bswap64(word);
+#endif
+                word ^= crc;
+                crc = t[7][word & 0xff] ^ t[6][(word >> 8) & 0xff]
+                      ^ t[5][(word >> 16) & 0xff] ^ t[4][(word >> 24) & 0xff]
+                      ^ t[3][(word >> 32) & 0xff] ^ t[2][(word >> 40) & 0xff]
+                      ^ t[1][(word >> 48) & 0xff] ^ t[0][word >> 56];
+                data += 8;
+                len -= 8;
+            }
+            while (len--) {
+                crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xff];
+            }
+            return crc;
+#endif
+        }
+
+    private:
+        static constexpr Table TABLE = detail::makeCrc32Table(POLYNOMIAL);
+
+        uint32_t _crc = INIT;
+    };
+}
@@ -0,0 +1,265 @@
+//
+// @Author: MorningXu
+// @Description: 十六进制字符串编解码，支持 SSSE3/AVX2
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace lanyueuav {
+    /**
+     * @brief 十六进制解码结果
+     */
+    struct HexResult {
+        size_t written;   //写入的字节数
+        size_t consumed;  //已处理的字符数；ok 为 false 时即非法字符的下标
+        bool ok;          //是否遇到非法字符
+    };
+
+    /**
+     * @brief 十六进制编解码，长度不限，输出写入调用者预先分配的缓冲区
+     *
+     * 编码输出大写字符。解码接受大小写，字节之间可以用空格分隔（与 StringHex::stringToHex 一致）。
+     * 输入末尾落单的半个字节不计入 consumed，流式调用时可将其拼到下一段输入前面。
+     */
+    class HexCodec {
+    public:
+        /**
+         * @brief 编码，不带分隔符
+         * @param in 字节序
+         * @param len 字节序长度
+         * @param out 输出，至少 2 * len 字节
+         * @return 写入的字符数
+         */
+        static size_t encode(const unsigned char *in, size_t len, char *out) {
+            size_t i = 0;
+            char *o = out;
+#ifdef __AVX2__
+            for (; i + 32 <= len; i += 32, o += 64) {
+                encode32(in + i, o);
+            }
+#endif
+#ifdef __SSSE3__
+            for (; i + 16 <= len; i += 16, o += 32) {
+                encode16(in + i, o);
+            }
+#endif
+            for (; i < len; i++, o += 2) {
+                o[0] = DIGITS[in[i] >> 4];
+                o[1] = DIGITS[in[i] & 0x0f];
+            }
+            return static_cast<size_t>(o - out);
+        }
+
+        /**
+         * @brief 编码，字节之间插入分隔符，末尾不带分隔符
+         * @param in 字节序
+         * @param len 字节序长度
+         * @param out 输出，至少 3 * len - 1 字节
+         * @param separator 分隔符
+         * @return 写入的字符数
+         */
+        static size_t encode(const unsigned char *in, size_t len, char *out, char separator) {
+            if (len == 0) {
+                return 0;
+            }
+            size_t i = 0;
+            char *o = out;
+#ifdef __SSSE3__
+            //最后一个字节留给标量路径，保证末尾不写分隔符
+            for (; i + 16 < len; i += 16, o += 48) {
+                encodeSpaced16(in + i, o, separator);
+            }
+#endif
+            for (; i + 1 < len; i++, o += 3) {
+                o[0] = DIGITS[in[i] >> 4];
+                o[1] = DIGITS[in[i] & 0x0f];
+                o[2] = separator;
+            }
+            o[0] = DIGITS[in[i] >> 4];
+            o[1] = DIGITS[in[i] & 0x0f];
+            return static_cast<size_t>(o - out) + 2;
+        }
+
+        /**
+         * @brief 解码
+         * @param in 字符串
+         * @param len 字符串长度
+         * @param out 输出，至少 len / 2 字节
+         * @return 解码结果，遇到非法字符时停止并给出其下标
+         */
+        static HexResult decode(const char *in, size_t len, unsigned char *out) {
+            size_t i = 0, o = 0;
+            while (i < len) {
+#ifdef __SSSE3__
+                if (len - i >= 32 && in[i + 2] != ' ') {
+                    if (decode16(in + i, out + o)) {
+                        i += 32;
+                        o += 16;
+                        continue;
+                    }
+                } else if (len - i >= 48 && decodeSpaced16(in + i, out + o)) {
+                    i += 48;
+                    o += 16;
+                    continue;
+                }
+#endif
+                if (in[i] == ' ') {
+                    i++;
+                    continue;
+                }
+                if (i + 1 >= len) {
+                    if (value(in[i]) < 0) return {o, i, false};
+                    break;
+                }
+                int hi = value(in[i]), lo = value(in[i + 1]);
+                if (hi < 0) return {o, i, false};
+                if (lo < 0) return {o, i + 1, false};
+                out[o++] = static_cast<unsigned char>((hi << 4) | lo);
+                i += 2;
+            }
+            return {o, i, true};
+        }
+
+        /**
+         * @return 十六进制字符对应的值，非法字符返回 -1
+         */
+        static inline int value(char ch) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            if (c >= '0' && c <= '9') return c - '0';
+            c |= 0x20;
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            return -1;
+        }
+
+    private:
+        static constexpr const char *DIGITS = "0123456789ABCDEF";
+
+#ifdef __SSSE3__
+        static inline __m128i nibbleChars(__m128i nibbles) {
+            const __m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                              '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+            return _mm_shuffle_epi8(lut, nibbles);
+        }
+
+        static inline void hexChars(__m128i x, __m128i &first, __m128i &second) {
+            const __m128i mask = _mm_set1_epi8(0x0f);
+            __m128i hi = nibbleChars(_mm_and_si128(_mm_srli_epi16(x, 4), mask));
+            __m128i lo = nibbleChars(_mm_and_si128(x, mask));
+            first = _mm_unpacklo_epi8(hi, lo);
+            second = _mm_unpackhi_epi8(hi, lo);
+        }
+
+        static inline void encode16(const unsigned char *in, char *out) {
+            __m128i first, second;
+            hexChars(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), first, second);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), first);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), second);
+        }
+
+        /**
+         * 16 字节编码为 48 个字符 "XX XX ... XX "，first/second 中为连续的 32 个十六进制字符
+         */
+        static inline void encodeSpaced16(const unsigned char *in, char *out, char separator) {
+            __m128i first, second;
+            hexChars(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), first, second);
+            const char z = static_cast<char>(0x80);
+            __m128i sep = _mm_set1_epi8(separator);
+            __m128i s0 = _mm_shuffle_epi8(first, _mm_setr_epi8(0, 1, z, 2, 3, z, 4, 5, z, 6, 7, z, 8, 9, z, 10));
+            __m128i m0 = _mm_setr_epi8(0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0);
+            __m128i s1 = _mm_or_si128(
+                    _mm_shuffle_epi8(first, _mm_setr_epi8(11, z, 12, 13, z, 14, 15, z, z, z, z, z, z, z, z, z)),
+                    _mm_shuffle_epi8(second, _mm_setr_epi8(z, z, z, z, z, z, z, z, 0, 1, z, 2, 3, z, 4, 5)));
+            __m128i m1 = _mm_setr_epi8(0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0);
+            __m128i s2 = _mm_shuffle_epi8(second, _mm_setr_epi8(z, 6, 7, z, 8, 9, z, 10, 11, z, 12, 13, z, 14, 15, z));
+            __m128i m2 = _mm_setr_epi8(-1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_or_si128(s0, _mm_and_si128(sep, m0)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), _mm_or_si128(s1, _mm_and_si128(sep, m1)));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 32), _mm_or_si128(s2, _mm_and_si128(sep, m2)));
+        }
+
+        /**
+         * 16 个十六进制字符转换为半字节值，valid 为全部合法时的标记
+         */
+        static inline __m128i nibbles(__m128i c, bool &valid) {
+            __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+            __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                             _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+            __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+            __m128i alpha = _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10));
+            __m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                             _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+            valid = _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) == 0xffff;
+            return _mm_or_si128(_mm_and_si128(is_digit, digit), _mm_and_si128(is_alpha, alpha));
+        }
+
+        static inline bool decodePairs(__m128i first, __m128i second, unsigned char *out) {
+            bool v0, v1;
+            __m128i n0 = nibbles(first, v0);
+            __m128i n1 = nibbles(second, v1);
+            if (!(v0 && v1)) {
+                return false;
+            }
+            //相邻两字节 [hi, lo] 合成 hi * 16 + lo
+            const __m128i weights = _mm_set1_epi16(0x0110);
+            __m128i b0 = _mm_maddubs_epi16(n0, weights);
+            __m128i b1 = _mm_maddubs_epi16(n1, weights);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(b0, b1));
+            return true;
+        }
+
+        static inline bool decode16(const char *in, unsigned char *out) {
+            return decodePairs(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 16)), out);
+        }
+
+        /**
+         * 48 个字符 "XX XX ... XX " 解码为 16 字节，分隔符必须全部为空格
+         */
+        static inline bool decodeSpaced16(const char *in, unsigned char *out) {
+            __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+            __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 16));
+            __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 32));
+            const __m128i space = _mm_set1_epi8(' ');
+            if ((_mm_movemask_epi8(_mm_cmpeq_epi8(r0, space)) & 0x4924) != 0x4924
+                || (_mm_movemask_epi8(_mm_cmpeq_epi8(r1, space)) & 0x2492) != 0x2492
+                || (_mm_movemask_epi8(_mm_cmpeq_epi8(r2, space)) & 0x9249) != 0x9249) {
+                return false;
+            }
+            const char z = static_cast<char>(0x80);
+            __m128i first = _mm_or_si128(
+                    _mm_shuffle_epi8(r0, _mm_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 12, 13, 15, z, z, z, z, z)),
+                    _mm_shuffle_epi8(r1, _mm_setr_epi8(z, z, z, z, z, z, z, z, z, z, z, 0, 2, 3, 5, 6)));
+            __m128i second = _mm_or_si128(
+                    _mm_shuffle_epi8(r1, _mm_setr_epi8(8, 9, 11, 12, 14, 15, z, z, z, z, z, z, z, z, z, z)),
+                    _mm_shuffle_epi8(r2, _mm_setr_epi8(z, z, z, z, z, z, 1, 2, 4, 5, 7, 8, 10, 11, 13, 14)));
+            return decodePairs(first, second, out);
+        }
+#endif
+
+#ifdef __AVX2__
+        static inline void encode32(const unsigned char *in, char *out) {
+            const __m256i lut = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                                 '8', '9', 'A', 'B', 'C', 'D', 'E', 'F',
+                                                 '0', '1', '2', '3', '4', '5', '6', '7',
+                                                 '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+            const __m256i mask = _mm256_set1_epi8(0x0f);
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in));
+            __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+            __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(x, mask));
+            //unpack 在 128 位通道内进行，需要重新排列两个通道
+            __m256i a = _mm256_unpacklo_epi8(hi, lo);
+            __m256i b = _mm256_unpackhi_epi8(hi, lo);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), _mm256_permute2x128_si256(a, b, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 32), _mm256_permute2x128_si256(a, b, 0x31));
+        }
+#endif
+    };
+}
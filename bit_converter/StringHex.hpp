@@ -9,6 +9,8 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include "Crc16.hpp"
+#include "HexCodec.hpp"
 
 namespace lanyueuav {
     class StringHex {
@@ -16,40 +18,28 @@ namespace lanyueuav {
         /**
         *string 转 hex 两个16位字符 中间已空格隔开
         *比如 02 02 00 01 00 01
-        *最多1024个字符
+        *长度不限，遇到非法字符时停止
         *  @return: int 数据字节数
         */
         static int stringToHex(const std::string &str, std::vector<unsigned char> &out) {
-            unsigned char hexdata, lowhexdata;
-            int len = str.length();
-
-            if (len > 1024) { //限制大小
-                len = 1024;
-            }
-
-            char lstr, hstr;
-
-            int counter = 0;
+            size_t error_offset;
+            return stringToHex(str, out, error_offset);
+        }
 
-            for (int i = 0; i < len; i++) {
-                //char lstr,
-                hstr = str[i];   //高位
-                if (hstr == ' ') {//跳过空格
-                    continue;
-                }
-                i++;
-                lstr = str[i]; //低位
-                hexdata = convertCharToHex(hstr);
-                lowhexdata = convertCharToHex(lstr);
-                if ((hexdata == 16) || (lowhexdata == 16))
-                    break;
-                else {
-                    hexdata = hexdata * 16 + lowhexdata;
-                    counter++;
-                }
-                out.push_back(hexdata);
-            }
-            return counter;
+        /**
+         * @brief string 转 hex，并给出非法字符的位置
+         * @param str
+         * @param out
+         * @param error_offset 第一个非法字符（或落单的半个字节）的下标，全部合法时为 std::string::npos
+         * @return int 数据字节数
+         */
+        static int stringToHex(const std::string &str, std::vector<unsigned char> &out, size_t &error_offset) {
+            size_t base = out.size();
+            out.resize(base + str.length() / 2);
+            HexResult result = HexCodec::decode(str.data(), str.length(), out.data() + base);
+            out.resize(base + result.written);
+            error_offset = result.consumed < str.length() ? result.consumed : std::string::npos;
+            return static_cast<int>(result.written);
         }
 
         /**
@@ -60,16 +50,12 @@ namespace lanyueuav {
          * @return string
          */
         static std::string charToHexString(const std::vector<unsigned char> &bytes, int len) {
-            const char HEX[] = "0123456789ABCDEF";
             std::string lStr;
-            for (int i = 0; i < len; i++) {
-                char lTemp = bytes[i];
-                lStr.push_back(HEX[(lTemp & 0xf0) >> 4]);
-                lStr.push_back(HEX[lTemp & 0x0f]);
-                if (i < len - 1) {
-                    lStr += " ";
-                }
+            if (len <= 0) {
+                return lStr;
             }
+            lStr.resize(static_cast<size_t>(len) * 3 - 1);
+            HexCodec::encode(bytes.data(), len, &lStr[0], ' ');
             return lStr;
         }
 
@@ -80,13 +66,12 @@ namespace lanyueuav {
          * @return
          */
         static std::string charToHexStringWithoutSpace(const std::vector<unsigned char> &bytes, int len) {
-            const char HEX[] = "0123456789ABCDEF";
             std::string lStr;
-            for (int i = 0; i < len; i++) {
-                char lTemp = bytes[i];
-                lStr.push_back(HEX[(lTemp & 0xf0) >> 4]);
-                lStr.push_back(HEX[lTemp & 0x0f]);
+            if (len <= 0) {
+                return lStr;
             }
+            lStr.resize(static_cast<size_t>(len) * 2);
+            HexCodec::encode(bytes.data(), len, &lStr[0]);
             return lStr;
         }
 
@@ -99,30 +84,29 @@ namespace lanyueuav {
          * @return false
          */
         static bool crc16(std::vector<unsigned char> &buffer, int len) {
-            int ret = 0;
-            unsigned short CRC = 0xffff;
-            unsigned short POLYNOMIAL = 0xa001;
-            int i, j;
-
-            if (len == 0) {
+            if (len <= 0) {
                 return false;
             }
+            unsigned char crc[2];
+            Crc16::store(Crc16::compute(buffer.data(), len), crc);
+            buffer.push_back(crc[0]);
+            buffer.push_back(crc[1]);
+            return true;
+        }
 
-            for (i = 0; i < len; i++) {
-                CRC ^= buffer[i];
-                for (j = 0; j < 8; j++) {
-                    if ((CRC & 0x0001) != 0) {
-                        CRC >>= 1;
-                        CRC ^= POLYNOMIAL;
-                    } else {
-                        CRC >>= 1;
-                    }
-                }
+        /**
+         * @brief 校验末尾两字节为 crc16 的数据，不修改buffer
+         *
+         * @param buffer
+         * @param len 含crc在内的长度
+         * @return true
+         * @return false
+         */
+        static bool isCrc16(const std::vector<unsigned char> &buffer, int len) {
+            if (len < 2 || static_cast<size_t>(len) > buffer.size()) {
+                return false;
             }
-
-            buffer.push_back((unsigned char) (CRC & 0x00ff));
-            buffer.push_back((unsigned char) (CRC >> 8));
-            return true;
+            return Crc16::verify(buffer.data(), len);
         }
 
         static std::string charToString(const std::vector<unsigned char> &in, int start, int len) {
@@ -133,15 +117,12 @@ namespace lanyueuav {
             return result;
         }
 
+        /**
+         * @return 十六进制字符对应的值，非法字符返回 16
+         */
         static char convertCharToHex(char ch) {
-            if ((ch >= '0') && (ch <= '9'))
-                return ch - 0x30;
-            else if ((ch >= 'A') && (ch <= 'F'))
-                return ch - 'A' + 10;
-            else if ((ch >= 'a') && (ch <= 'f'))
-                return ch - 'a' + 10;
-            else
-                return (-1);
+            int value = HexCodec::value(ch);
+            return static_cast<char>(value < 0 ? 16 : value);
         }
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,479 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: Modbus RTU 主站
+* @copyright:
+*/
+
+#include "ModbusMaster.h"
+#include "Crc16.hpp"
+
+#include <poll.h>
+#include <time.h>
+#include <algorithm>
+#include <cerrno>
+#include <map>
+
+using lanyueuav::Crc16;
+
+ModbusMaster::Options ModbusMaster::defaultOptions = {
+        100,    // timeoutMs
+        1,      // retries
+        125,    // maxRegisters
+        8,      // maxGap
+        2000,   // gapSlackUs
+        3,      // offlineAfter
+        1000,   // offlineRetryMs
+};
+
+namespace {
+    const uint16_t MAX_READ_REGISTERS = 125;
+    const uint16_t MAX_WRITE_REGISTERS = 123;
+
+    void sleepUntil(uint64_t ns) {
+        struct timespec ts{};
+        ts.tv_sec = static_cast<time_t>(ns / 1000000000ull);
+        ts.tv_nsec = static_cast<long>(ns % 1000000000ull);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+    }
+
+    //等待可读或可写，timeout_ns 为 0 时立即返回
+    bool waitReady(int fd, short events, uint64_t timeout_ns) {
+        struct pollfd pfd{fd, events, 0};
+        struct timespec ts{};
+        ts.tv_sec = static_cast<time_t>(timeout_ns / 1000000000ull);
+        ts.tv_nsec = static_cast<long>(timeout_ns % 1000000000ull);
+        int ret;
+        do {
+            ret = ppoll(&pfd, 1, &ts, nullptr);
+        } while (ret < 0 && errno == EINTR);
+        return ret > 0;
+    }
+
+    bool isRead(ModbusMaster::Function function) {
+        return function == ModbusMaster::ReadHoldingRegisters || function == ModbusMaster::ReadInputRegisters;
+    }
+
+    void putU16(std::vector<unsigned char> &out, uint16_t value) {
+        out.push_back(static_cast<unsigned char>(value >> 8));
+        out.push_back(static_cast<unsigned char>(value & 0xff));
+    }
+
+    uint16_t getU16(const unsigned char *in) {
+        return static_cast<uint16_t>((in[0] << 8) | in[1]);
+    }
+}
+
+ModbusMaster::ModbusMaster(SerialPort &port, Options options)
+        : _port(port), _options(options) {
+    _options.maxRegisters = std::min<uint16_t>(std::max<uint16_t>(_options.maxRegisters, 1), MAX_READ_REGISTERS);
+    _response.reserve(256);
+    _values.reserve(MAX_READ_REGISTERS);
+}
+
+void ModbusMaster::silentIntervals(unsigned long baud, uint64_t charNs, uint64_t &t15Ns, uint64_t &t35Ns) {
+    //高波特率下字符时间过短，协议规定固定使用 750us/1750us
+    if (baud > 19200 || charNs == 0) {
+        t15Ns = 750000;
+        t35Ns = 1750000;
+        return;
+    }
+    t15Ns = charNs * 3 / 2;
+    t35Ns = charNs * 7 / 2;
+}
+
+uint64_t ModbusMaster::t15Ns() const {
+    uint64_t t15, t35;
+    silentIntervals(_port.actualBaudRate(), _port.wireTimeNs(1), t15, t35);
+    return t15;
+}
+
+uint64_t ModbusMaster::t35Ns() const {
+    uint64_t t15, t35;
+    silentIntervals(_port.actualBaudRate(), _port.wireTimeNs(1), t15, t35);
+    return t35;
+}
+
+int ModbusMaster::addPoll(uint8_t slave, Function function, uint16_t address, uint16_t count, Handler handler,
+                          uint32_t timeoutMs) {
+    if (slave == 0 || slave > 247 || !isRead(function) || count == 0 || count > MAX_READ_REGISTERS
+        || address + count > 0x10000) {
+        return -1;
+    }
+    PollItem item{slave, function, address, count, std::move(handler), timeoutMs ? timeoutMs : _options.timeoutMs};
+    if (_notifying) {
+        //回调期间 notify 仍在遍历 _items，推迟到回调结束
+        _deferred_items.push_back(std::move(item));
+        return static_cast<int>((_deferred_clear ? 0 : _items.size()) + _deferred_items.size() - 1);
+    }
+    _items.push_back(std::move(item));
+    _planned = false;
+    return static_cast<int>(_items.size() - 1);
+}
+
+void ModbusMaster::clearPolls() {
+    if (_notifying) {
+        _deferred_clear = true;
+        _deferred_items.clear();
+        return;
+    }
+    _items.clear();
+    _planned = false;
+}
+
+size_t ModbusMaster::plannedRequests() {
+    if (!_planned) plan();
+    return _plan.size();
+}
+
+bool ModbusMaster::read(uint8_t slave, Function function, uint16_t address, uint16_t count, Handler handler,
+                        uint32_t timeoutMs) {
+    if (slave == 0 || slave > 247 || !isRead(function) || count == 0 || count > MAX_READ_REGISTERS
+        || address + count > 0x10000) {
+        return false;
+    }
+    Request request{slave, function, address, count, encode(slave, function, address, count, nullptr), {},
+                    std::move(handler), timeoutMs ? timeoutMs : _options.timeoutMs};
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pending.push_back(std::move(request));
+    return true;
+}
+
+bool ModbusMaster::write(uint8_t slave, uint16_t address, const uint16_t *values, uint16_t count, Handler handler,
+                         uint32_t timeoutMs) {
+    if (slave == 0 || slave > 247 || values == nullptr || count == 0 || count > MAX_WRITE_REGISTERS
+        || address + count > 0x10000) {
+        return false;
+    }
+    Function function = count == 1 ? WriteSingleRegister : WriteMultipleRegisters;
+    Request request{slave, function, address, count, encode(slave, function, address, count, values), {},
+                    std::move(handler), timeoutMs ? timeoutMs : _options.timeoutMs};
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pending.push_back(std::move(request));
+    return true;
+}
+
+size_t ModbusMaster::cycle() {
+    size_t count = 0;
+    Request request;
+    while (takePending(request)) {
+        execute(request);
+        count++;
+    }
+    if (!_planned) plan();
+    //回调修改了轮询项时计划已失效，提前结束本周期
+    for (_next = 0; _next < _plan.size() && _planned; _next++) {
+        if (isOffline(_plan[_next].slave, SerialPortStats::nowNs())) continue;
+        execute(_plan[_next]);
+        count++;
+    }
+    _next = 0;
+    return count;
+}
+
+bool ModbusMaster::poll() {
+    Request request;
+    if (takePending(request)) {
+        execute(request);
+        return true;
+    }
+    if (!_planned) plan();
+    if (_plan.empty()) {
+        return false;
+    }
+    uint64_t now = SerialPortStats::nowNs();
+    uint64_t earliest = UINT64_MAX;
+    for (size_t i = 0; i < _plan.size(); i++) {
+        Request &next = _plan[_next];
+        _next = (_next + 1) % _plan.size();
+        if (!isOffline(next.slave, now)) {
+            execute(next);
+            return true;
+        }
+        earliest = std::min(earliest, _slaves[next.slave].retryAt);
+    }
+    //所有从站都离线，等待最早的重试时间，期间提交的一次性请求最迟一个超时后执行
+    sleepUntil(std::min<uint64_t>(earliest, now + _options.timeoutMs * 1000000ull));
+    return true;
+}
+
+uint64_t ModbusMaster::transactions() const {
+    return _transactions.load(std::memory_order_relaxed);
+}
+
+uint64_t ModbusMaster::timeouts() const {
+    return _timeouts.load(std::memory_order_relaxed);
+}
+
+uint64_t ModbusMaster::crcErrors() const {
+    return _crc_errors.load(std::memory_order_relaxed);
+}
+
+std::vector<unsigned char> ModbusMaster::encode(uint8_t slave, Function function, uint16_t address, uint16_t count,
+                                                const uint16_t *values) {
+    std::vector<unsigned char> frame;
+    frame.reserve(9 + 2 * count);
+    frame.push_back(slave);
+    frame.push_back(static_cast<unsigned char>(function));
+    putU16(frame, address);
+    if (function == WriteSingleRegister) {
+        putU16(frame, values[0]);
+    } else {
+        putU16(frame, count);
+        if (function == WriteMultipleRegisters) {
+            frame.push_back(static_cast<unsigned char>(count * 2));
+            for (uint16_t i = 0; i < count; i++) putU16(frame, values[i]);
+        }
+    }
+    unsigned char crc[2];
+    Crc16::store(Crc16::compute(frame.data(), frame.size()), crc);
+    frame.push_back(crc[0]);
+    frame.push_back(crc[1]);
+    return frame;
+}
+
+size_t ModbusMaster::expectedLength(const unsigned char *frame, size_t size) {
+    if (size < 2) {
+        return 0;
+    }
+    if (frame[1] & 0x80) {
+        return 5; //地址 功能码|0x80 异常码 CRC
+    }
+    switch (frame[1]) {
+        case ReadHoldingRegisters:
+        case ReadInputRegisters:
+            return size < 3 ? 0 : 5 + static_cast<size_t>(frame[2]);
+        case WriteSingleRegister:
+        case WriteMultipleRegisters:
+            return 8;
+        default:
+            return 0; //未知功能码，由字符间隔判定帧结束
+    }
+}
+
+void ModbusMaster::plan() {
+    std::vector<size_t> order(_items.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        const PollItem &a = _items[lhs], &b = _items[rhs];
+        if (a.slave != b.slave) return a.slave < b.slave;
+        if (a.function != b.function) return a.function < b.function;
+        return a.address < b.address;
+    });
+
+    //按从站分组合并：与当前请求相距不超过 maxGap 且合并后不超过 maxRegisters 时并入
+    std::map<uint8_t, std::vector<Request>> bySlave;
+    for (size_t k = 0; k < order.size();) {
+        const PollItem &first = _items[order[k]];
+        uint32_t begin = first.address;
+        uint32_t end = begin + first.count;
+        uint32_t timeoutMs = first.timeoutMs;
+        std::vector<size_t> merged{order[k]};
+        for (k++; k < order.size(); k++) {
+            const PollItem &item = _items[order[k]];
+            uint32_t itemEnd = static_cast<uint32_t>(item.address) + item.count;
+            if (item.slave != first.slave || item.function != first.function
+                || item.address > end + _options.maxGap
+                || std::max(end, itemEnd) - begin > _options.maxRegisters) {
+                break;
+            }
+            end = std::max(end, itemEnd);
+            timeoutMs = std::max(timeoutMs, item.timeoutMs);
+            merged.push_back(order[k]);
+        }
+        auto count = static_cast<uint16_t>(end - begin);
+        auto address = static_cast<uint16_t>(begin);
+        bySlave[first.slave].push_back(Request{first.slave, first.function, address, count,
+                                               encode(first.slave, first.function, address, count, nullptr),
+                                               std::move(merged), nullptr, timeoutMs});
+    }
+
+    //按从站轮转排列，一个从站的多个请求之间穿插其它从站
+    _plan.clear();
+    for (size_t round = 0; _plan.size() < _items.size(); round++) {
+        bool any = false;
+        for (auto &entry: bySlave) {
+            if (round < entry.second.size()) {
+                _plan.push_back(std::move(entry.second[round]));
+                any = true;
+            }
+        }
+        if (!any) break;
+    }
+    _next = 0;
+    _planned = true;
+}
+
+bool ModbusMaster::takePending(Request &request) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_pending.empty()) {
+        return false;
+    }
+    request = std::move(_pending.front());
+    _pending.pop_front();
+    return true;
+}
+
+bool ModbusMaster::isOffline(uint8_t slave, uint64_t now) const {
+    const SlaveState &state = _slaves[slave];
+    return _options.offlineAfter != 0 && state.timeouts >= _options.offlineAfter && now < state.retryAt;
+}
+
+void ModbusMaster::execute(Request &request) {
+    Status status = StatusTimeout;
+    for (unsigned attempt = 0; attempt <= _options.retries; attempt++) {
+        status = transact(request, _response);
+        if (status != StatusTimeout && status != StatusCrcError) break;
+    }
+    SlaveState &state = _slaves[request.slave];
+    if (status == StatusTimeout) {
+        if (state.timeouts < 255) state.timeouts++;
+        state.retryAt = SerialPortStats::nowNs() + _options.offlineRetryMs * 1000000ull;
+    } else {
+        state.timeouts = 0;
+    }
+    complete(request, status, _response);
+}
+
+ModbusMaster::Status ModbusMaster::transact(const Request &request, std::vector<unsigned char> &response) {
+    waitIdle();
+    //丢弃上一个事务超时后迟到的应答
+    unsigned char stale[64];
+    while (_port.read(stale, sizeof(stale)) > 0) {}
+
+    _transactions.fetch_add(1, std::memory_order_relaxed);
+    if (!send(request.frame, request.timeoutMs)) {
+        _idle_at = SerialPortStats::nowNs() + t35Ns();
+        return StatusPortError;
+    }
+    //write 返回时数据只是进入了驱动缓冲区，超时从请求在线路上发送完毕开始计算
+    uint64_t deadline = SerialPortStats::nowNs() + _port.wireTimeNs(request.frame.size())
+                        + request.timeoutMs * 1000000ull;
+    Status status = receive(deadline, response);
+    //应答最后一个字节之后（或超时之后）保持 t3.5 静默
+    _idle_at = SerialPortStats::nowNs() + t35Ns();
+    if (status == StatusTimeout) {
+        _timeouts.fetch_add(1, std::memory_order_relaxed);
+        return status;
+    }
+    if (status == StatusOk && !Crc16::verify(response.data(), response.size())) {
+        status = StatusCrcError;
+    }
+    if (status == StatusCrcError) {
+        _crc_errors.fetch_add(1, std::memory_order_relaxed);
+        return status;
+    }
+    if (response[0] != request.slave || (response[1] & 0x7f) != request.function) {
+        return StatusInvalid;
+    }
+    if (response[1] & 0x80) {
+        return StatusException;
+    }
+    if (isRead(request.function)) {
+        return response[2] == request.count * 2 ? StatusOk : StatusInvalid;
+    }
+    //写请求的应答回显地址与值（或数量）
+    return std::equal(response.begin() + 2, response.begin() + 6, request.frame.begin() + 2)
+           ? StatusOk : StatusInvalid;
+}
+
+bool ModbusMaster::send(const std::vector<unsigned char> &frame, uint32_t timeoutMs) {
+    //整个请求共用一个截止时间，线路卡住（如流控阻塞）时不会无限等待
+    uint64_t deadline = SerialPortStats::nowNs() + _port.wireTimeNs(frame.size()) + timeoutMs * 1000000ull;
+    size_t sent = 0;
+    while (sent < frame.size()) {
+        int ret = _port.write(frame.data() + sent, static_cast<int>(frame.size() - sent));
+        if (ret > 0) {
+            sent += ret;
+            continue;
+        }
+        if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            return false;
+        }
+        uint64_t now = SerialPortStats::nowNs();
+        if (now >= deadline) {
+            return false;
+        }
+        waitReady(_port.fd(), POLLOUT, deadline - now);
+    }
+    return true;
+}
+
+ModbusMaster::Status ModbusMaster::receive(uint64_t deadline, std::vector<unsigned char> &response) {
+    response.clear();
+    //字符间隔从上一次收到数据开始计算，加上一个字符时间
+    uint64_t gap = t15Ns() + _port.wireTimeNs(1) + _options.gapSlackUs * 1000ull;
+    uint64_t last = 0;
+    unsigned char buf[256];
+    for (;;) {
+        size_t expected = expectedLength(response.data(), response.size());
+        if (expected != 0 && response.size() >= expected) {
+            response.resize(expected);
+            return StatusOk;
+        }
+        uint64_t now = SerialPortStats::nowNs();
+        uint64_t until = response.empty() ? deadline : last + gap;
+        if (now >= until) {
+            return response.empty() ? StatusTimeout : StatusCrcError;
+        }
+        if (!waitReady(_port.fd(), POLLIN, until - now)) {
+            continue;
+        }
+        int ret = _port.read(buf, sizeof(buf));
+        if (ret > 0) {
+            response.insert(response.end(), buf, buf + ret);
+            last = SerialPortStats::nowNs();
+        } else if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            return response.empty() ? StatusTimeout : StatusCrcError;
+        }
+    }
+}
+
+void ModbusMaster::complete(Request &request, Status status, const std::vector<unsigned char> &response) {
+    uint8_t exception = status == StatusException ? response[2] : 0;
+    if (status != StatusOk || !isRead(request.function)) {
+        notify(request, status, nullptr, exception);
+        return;
+    }
+    _values.resize(request.count);
+    for (uint16_t i = 0; i < request.count; i++) {
+        _values[i] = getU16(response.data() + 3 + 2 * i);
+    }
+    notify(request, status, _values.data(), 0);
+}
+
+void ModbusMaster::notify(Request &request, Status status, const uint16_t *values, uint8_t exception) {
+    _notifying = true;
+    if (request.items.empty()) {
+        if (request.handler) request.handler(status, values, request.count, exception);
+    } else {
+        //合并请求按各轮询项的地址范围拆分回调
+        for (size_t index: request.items) {
+            const PollItem &item = _items[index];
+            if (!item.handler) continue;
+            item.handler(status, values ? values + (item.address - request.address) : nullptr, item.count,
+                         exception);
+        }
+    }
+    _notifying = false;
+    applyDeferred();
+}
+
+void ModbusMaster::applyDeferred() {
+    if (!_deferred_clear && _deferred_items.empty()) {
+        return;
+    }
+    if (_deferred_clear) _items.clear();
+    for (auto &item: _deferred_items) _items.push_back(std::move(item));
+    _deferred_items.clear();
+    _deferred_clear = false;
+    _planned = false;
+}
+
+void ModbusMaster::waitIdle() {
+    uint64_t now = SerialPortStats::nowNs();
+    if (now < _idle_at) {
+        sleepUntil(_idle_at);
+    }
+}
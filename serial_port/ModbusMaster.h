@@ -0,0 +1,218 @@
+//
+// @Author: MorningXu
+// @Description: Modbus RTU 主站，按波特率计算帧间隔并合并轮询请求
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "SerialPort.h"
+
+/**
+ * @brief Modbus RTU 主站
+ *
+ * RTU 总线同一时刻只允许一个未完成的事务，因此总线利用率取决于两次事务之间的空闲：
+ * 收到应答后只等待 t3.5 即发出下一请求（不使用固定 sleep），下一请求的报文提前编码好；
+ * 同一从站、同一功能码的相邻寄存器轮询合并为尽量少的请求，一个周期内按从站轮转，
+ * 连续超时的从站在 offlineRetryMs 内跳过，避免离线设备用超时占满总线。
+ *
+ * 事务在调用 poll()/cycle() 的线程中同步执行；read/write 可在任意线程提交，
+ * 在下一次事务之前优先执行。回调在执行事务的线程中调用。
+ * 回调中可以调用 addPoll/clearPolls，修改推迟到本次事务的回调全部结束后生效，
+ * cycle() 随即结束本周期，下一次 poll()/cycle() 按新的轮询计划执行。
+ */
+class ModbusMaster {
+public:
+    enum Function {
+        ReadHoldingRegisters = 0x03,
+        ReadInputRegisters = 0x04,
+        WriteSingleRegister = 0x06,
+        WriteMultipleRegisters = 0x10
+    };
+
+    enum Status {
+        StatusOk,
+        StatusTimeout,      //超时未收到完整应答
+        StatusCrcError,     //应答 CRC 错误或帧不完整
+        StatusException,    //从站返回异常应答
+        StatusInvalid,      //应答与请求不符
+        StatusPortError     //串口写失败或超时未能写完
+    };
+
+    /**
+     * @brief 事务完成回调
+     * @param status 结果
+     * @param values 读请求为读到的寄存器，写请求为 nullptr；仅在回调期间有效
+     * @param count 寄存器个数
+     * @param exception 异常码，status 为 StatusException 时有效
+     */
+    using Handler = std::function<void(Status status, const uint16_t *values, size_t count, uint8_t exception)>;
+
+    struct Options {
+        uint32_t timeoutMs;         //从请求发送完毕到应答开始的超时(毫秒)，请求未单独指定时使用
+        uint8_t retries;            //超时或 CRC 错误时的重试次数
+        uint16_t maxRegisters;      //合并后单个读请求的最大寄存器数，协议上限 125
+        uint16_t maxGap;            //两段轮询之间最多间隔多少个寄存器仍然合并
+        uint32_t gapSlackUs;        //字符间隔超过 t1.5 + gapSlackUs 视为帧结束，吸收 USB 串口的上送延迟
+        uint8_t offlineAfter;       //连续超时达到该次数视为离线，0 表示不跳过
+        uint32_t offlineRetryMs;    //离线从站的轮询跳过多久后再试一次(毫秒)，跳过期间不回调
+    };
+
+    static Options defaultOptions;
+
+    /**
+     * @param port 串口，生命周期需长于主站
+     * @param options 参数
+     */
+    explicit ModbusMaster(SerialPort &port, Options options = defaultOptions);
+
+    ModbusMaster(const ModbusMaster &) = delete;
+
+    ModbusMaster &operator=(const ModbusMaster &) = delete;
+
+    /**
+     * @brief 按波特率计算 t1.5/t3.5(纳秒)，波特率高于 19200 时按协议固定为 750/1750 微秒
+     * @param charNs 单个字符在线路上的时间，见 SerialPort::wireTimeNs
+     */
+    static void silentIntervals(unsigned long baud, uint64_t charNs, uint64_t &t15Ns, uint64_t &t35Ns);
+
+    //当前串口的 t1.5(纳秒)
+    uint64_t t15Ns() const;
+
+    //当前串口的 t3.5(纳秒)
+    uint64_t t35Ns() const;
+
+    /**
+     * @brief 添加周期轮询
+     * @param slave 从站地址 1~247
+     * @param function ReadHoldingRegisters 或 ReadInputRegisters
+     * @param address 起始寄存器
+     * @param count 寄存器个数
+     * @param handler 每个周期读到数据或失败时回调
+     * @param timeoutMs 该轮询的应答超时(毫秒)，0 表示使用 Options::timeoutMs；合并的请求取其中最长的超时
+     * @return 轮询编号，参数无效返回 -1；回调中调用时为生效后的编号
+     */
+    int addPoll(uint8_t slave, Function function, uint16_t address, uint16_t count, Handler handler,
+                uint32_t timeoutMs = 0);
+
+    //移除全部轮询，回调中调用时推迟到回调结束后生效
+    void clearPolls();
+
+    //合并后每个周期的请求数
+    size_t plannedRequests();
+
+    /**
+     * @brief 提交一次读请求，不参与合并
+     * @param timeoutMs 应答超时(毫秒)，0 表示使用 Options::timeoutMs
+     */
+    bool read(uint8_t slave, Function function, uint16_t address, uint16_t count, Handler handler,
+              uint32_t timeoutMs = 0);
+
+    /**
+     * @brief 提交一次写请求，count 为 1 时使用 WriteSingleRegister
+     * @param timeoutMs 应答超时(毫秒)，0 表示使用 Options::timeoutMs
+     */
+    bool write(uint8_t slave, uint16_t address, const uint16_t *values, uint16_t count, Handler handler,
+               uint32_t timeoutMs = 0);
+
+    /**
+     * @brief 执行已提交的一次性请求，再执行一个完整的轮询周期
+     * @return 本周期执行的事务数
+     */
+    size_t cycle();
+
+    /**
+     * @brief 执行下一个事务：优先执行已提交的一次性请求，否则按轮询计划执行下一请求
+     * 所有从站都离线时最多等待 timeoutMs 后返回
+     * @return 没有任何请求时返回 false
+     */
+    bool poll();
+
+    //累计事务数、超时数、CRC 错误数
+    uint64_t transactions() const;
+
+    uint64_t timeouts() const;
+
+    uint64_t crcErrors() const;
+
+private:
+    struct PollItem {
+        uint8_t slave;
+        Function function;
+        uint16_t address;
+        uint16_t count;
+        Handler handler;
+        uint32_t timeoutMs;
+    };
+
+    //一次事务，frame 为编码好的请求报文
+    struct Request {
+        uint8_t slave;
+        Function function;
+        uint16_t address;
+        uint16_t count;
+        std::vector<unsigned char> frame;
+        std::vector<size_t> items;  //合并的轮询项，为空表示一次性请求
+        Handler handler;
+        uint32_t timeoutMs;         //应答超时(毫秒)，已按 Options::timeoutMs 补全
+    };
+
+    struct SlaveState {
+        uint8_t timeouts;   //连续超时次数
+        uint64_t retryAt;   //离线时下次尝试的时间点(单调时钟纳秒)
+    };
+
+    static std::vector<unsigned char> encode(uint8_t slave, Function function, uint16_t address, uint16_t count,
+                                             const uint16_t *values);
+
+    static size_t expectedLength(const unsigned char *frame, size_t size);
+
+    void plan();
+
+    bool takePending(Request &request);
+
+    bool isOffline(uint8_t slave, uint64_t now) const;
+
+    void execute(Request &request);
+
+    Status transact(const Request &request, std::vector<unsigned char> &response);
+
+    bool send(const std::vector<unsigned char> &frame, uint32_t timeoutMs);
+
+    Status receive(uint64_t deadline, std::vector<unsigned char> &response);
+
+    void complete(Request &request, Status status, const std::vector<unsigned char> &response);
+
+    void notify(Request &request, Status status, const uint16_t *values, uint8_t exception);
+
+    //应用回调中推迟的 addPoll/clearPolls
+    void applyDeferred();
+
+    void waitIdle();
+
+    SerialPort &_port;
+    Options _options;
+    std::vector<PollItem> _items;
+    bool _notifying = false;              //正在执行回调，轮询项的修改推迟
+    bool _deferred_clear = false;
+    std::vector<PollItem> _deferred_items;
+    std::vector<Request> _plan;
+    bool _planned = true;
+    size_t _next = 0;                     //下一个执行的计划请求
+    SlaveState _slaves[256] = {};
+    uint64_t _idle_at = 0;                //总线空闲时间点(单调时钟纳秒)
+    std::vector<unsigned char> _response;
+    std::vector<uint16_t> _values;
+    std::mutex _mutex;                    //保护 _pending
+    std::deque<Request> _pending;
+    std::atomic<uint64_t> _transactions{0};
+    std::atomic<uint64_t> _timeouts{0};
+    std::atomic<uint64_t> _crc_errors{0};
+};
@@ -0,0 +1,32 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: 通过 termios2/BOTHER 设置任意波特率
+* @copyright:
+*/
+
+#include "SerialBaud.h"
+
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+
+bool SerialBaud::set(int fd, unsigned long baud) {
+    struct termios2 tios{};
+    if (ioctl(fd, TCGETS2, &tios) < 0) {
+        return false;
+    }
+    tios.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+    tios.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+    tios.c_ispeed = static_cast<speed_t>(baud);
+    tios.c_ospeed = static_cast<speed_t>(baud);
+    return ioctl(fd, TCSETS2, &tios) == 0;
+}
+
+unsigned long SerialBaud::actual(int fd) {
+    struct termios2 tios{};
+    if (ioctl(fd, TCGETS2, &tios) < 0) {
+        return 0;
+    }
+    return tios.c_ospeed;
+}
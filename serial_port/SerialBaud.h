@@ -0,0 +1,30 @@
+//
+// @Author: MorningXu
+// @Description: 通过 termios2/BOTHER 设置任意波特率
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+/**
+ * @brief termios2 接口
+ *
+ * <asm/termbits.h> 与 <termios.h> 不能同时包含，因此单独放在一个编译单元中，
+ * 头文件不引入任何 termios 定义。
+ */
+class SerialBaud {
+public:
+    /**
+     * @brief 以 BOTHER 设置输入输出波特率，其它 termios 设置保持不变
+     * @param fd 串口文件描述符
+     * @param baud 波特率，如 250000、1843200
+     * @return 驱动不支持时返回 false
+     */
+    static bool set(int fd, unsigned long baud);
+
+    /**
+     * @brief 读回驱动实际设置的输出波特率（驱动会按分频取整）
+     * @return 失败返回 0
+     */
+    static unsigned long actual(int fd);
+};
@@ -0,0 +1,119 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: 串口原始数据录制
+* @copyright:
+*/
+
+#include "SerialCapture.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+
+constexpr char CaptureFormat::MAGIC[8];
+
+std::string CaptureFormat::segmentPath(const std::string &prefix, unsigned index) {
+    char suffix[24];
+    snprintf(suffix, sizeof(suffix), ".%06u.cap", index);
+    return prefix + suffix;
+}
+
+SerialCapture::SerialCapture(std::string prefix, size_t segment_size)
+        : _prefix(std::move(prefix)), _segment_size(segment_size) {
+    openSegment(0);
+}
+
+SerialCapture::~SerialCapture() {
+    close();
+}
+
+bool SerialCapture::isOpen() const {
+    return _map != nullptr;
+}
+
+bool SerialCapture::append(const void *data, size_t length, uint64_t timestamp_ns) {
+    size_t need = CaptureFormat::recordSize(length);
+    if (_map == nullptr || _offset + need > _map_size) {
+        closeSegment();
+        if (!openSegment(need)) return false;
+    }
+    unsigned char *record = _map + _offset;
+    auto len = static_cast<uint32_t>(length);
+    memcpy(record, &timestamp_ns, sizeof(timestamp_ns));
+    memcpy(record + 8, &len, sizeof(len));
+    memcpy(record + CaptureFormat::RECORD_HEADER_SIZE, data, length);
+    _offset += need;
+    _bytes += length;
+    //记录写完后再发布结束偏移
+    __atomic_store_n(reinterpret_cast<uint64_t *>(_map + CaptureFormat::DATA_END_OFFSET),
+                     static_cast<uint64_t>(_offset), __ATOMIC_RELEASE);
+    return true;
+}
+
+void SerialCapture::close() {
+    closeSegment();
+}
+
+uint64_t SerialCapture::bytes() const {
+    return _bytes;
+}
+
+unsigned SerialCapture::segments() const {
+    return _segments;
+}
+
+bool SerialCapture::openSegment(size_t min_size) {
+    size_t size = _segment_size;
+    if (size < CaptureFormat::FILE_HEADER_SIZE + min_size) {
+        size = CaptureFormat::FILE_HEADER_SIZE + min_size;
+    }
+    std::string path = CaptureFormat::segmentPath(_prefix, _segments);
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    //预分配磁盘块，避免写映射内存时因磁盘满触发 SIGBUS
+    if (posix_fallocate(fd, 0, static_cast<off_t>(size)) != 0 && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        return false;
+    }
+    void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+    _fd = fd;
+    _map = static_cast<unsigned char *>(map);
+    _map_size = size;
+    _offset = CaptureFormat::FILE_HEADER_SIZE;
+    _segments++;
+
+    memset(_map, 0, CaptureFormat::FILE_HEADER_SIZE);
+    memcpy(_map, CaptureFormat::MAGIC, sizeof(CaptureFormat::MAGIC));
+    uint32_t version = CaptureFormat::VERSION;
+    auto header_size = static_cast<uint32_t>(CaptureFormat::FILE_HEADER_SIZE);
+    uint64_t data_end = _offset;
+    memcpy(_map + 8, &version, sizeof(version));
+    memcpy(_map + 12, &header_size, sizeof(header_size));
+    memcpy(_map + CaptureFormat::DATA_END_OFFSET, &data_end, sizeof(data_end));
+    return true;
+}
+
+void SerialCapture::closeSegment() {
+    if (_map == nullptr) {
+        return;
+    }
+    munmap(_map, _map_size);
+    //去掉未使用的预分配空间
+    int ret = ftruncate(_fd, static_cast<off_t>(_offset));
+    (void) ret;
+    ::close(_fd);
+    _map = nullptr;
+    _fd = -1;
+    _map_size = 0;
+}
@@ -0,0 +1,89 @@
+//
+// @Author: MorningXu
+// @Description: 串口原始数据录制，写入预分配的内存映射分段文件
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 录制文件格式
+ *
+ * 每个分段文件名为 prefix.000000.cap、prefix.000001.cap ...
+ * 文件头 64 字节：magic "SPCAP\0\0\0" | version(u32) | header_size(u32) | data_end(u64) | 保留
+ * 之后为连续的记录：timestamp_ns(u64) | length(u32) | 保留(u32) | 数据 | 填充到 8 字节对齐
+ * 所有整数均为小端，data_end 为已提交记录的结束偏移，进程崩溃时之前的记录仍然完整可读。
+ */
+struct CaptureFormat {
+    static constexpr char MAGIC[8] = {'S', 'P', 'C', 'A', 'P', 0, 0, 0};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t FILE_HEADER_SIZE = 64;
+    static constexpr size_t DATA_END_OFFSET = 16;
+    static constexpr size_t RECORD_HEADER_SIZE = 16;
+
+    static size_t recordSize(size_t length) {
+        return RECORD_HEADER_SIZE + ((length + 7) & ~static_cast<size_t>(7));
+    }
+
+    static std::string segmentPath(const std::string &prefix, unsigned index);
+};
+
+/**
+ * @brief 录制 SerialPort::read 返回的原始片段
+ *
+ * 分段文件创建时一次性预分配并映射，append 只做内存拷贝，不产生系统调用；
+ * 分段写满时切换到下一个分段。只能在一个线程中调用 append，
+ * 通常通过 SerialPort::setCapture 挂在读线程上。
+ */
+class SerialCapture {
+public:
+    /**
+     * @param prefix 分段文件路径前缀
+     * @param segment_size 单个分段文件大小(字节)
+     */
+    explicit SerialCapture(std::string prefix, size_t segment_size = 64u << 20);
+
+    ~SerialCapture();
+
+    SerialCapture(const SerialCapture &) = delete;
+
+    SerialCapture &operator=(const SerialCapture &) = delete;
+
+    bool isOpen() const;
+
+    /**
+     * @brief 追加一个片段
+     * @param data 数据
+     * @param length 数据长
+     * @param timestamp_ns 到达时间(单调时钟纳秒)
+     * @return 创建新分段失败时返回 false
+     */
+    bool append(const void *data, size_t length, uint64_t timestamp_ns);
+
+    //截断最后一个分段的预分配空间并关闭
+    void close();
+
+    //已录制的数据字节数（不含记录头）
+    uint64_t bytes() const;
+
+    //已创建的分段数
+    unsigned segments() const;
+
+private:
+    bool openSegment(size_t min_size);
+
+    void closeSegment();
+
+    std::string _prefix;
+    size_t _segment_size;
+    int _fd = -1;
+    unsigned char *_map = nullptr;
+    size_t _map_size = 0;
+    size_t _offset = 0;
+    unsigned _segments = 0;
+    uint64_t _bytes = 0;
+};
@@ -0,0 +1,277 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: 串口设备枚举
+* @copyright:
+*/
+
+#include "SerialEnumerator.h"
+
+#include <dirent.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <linux/netlink.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    const char *const SYS_CLASS_TTY = "/sys/class/tty";
+
+    std::string readAttribute(const std::string &path) {
+        std::ifstream in(path);
+        std::string value;
+        std::getline(in, value);
+        while (!value.empty() && (value.back() == '\n' || value.back() == ' ')) {
+            value.pop_back();
+        }
+        return value;
+    }
+
+    std::string readLink(const std::string &path) {
+        char target[PATH_MAX];
+        ssize_t n = readlink(path.c_str(), target, sizeof(target) - 1);
+        if (n <= 0) {
+            return "";
+        }
+        target[n] = 0;
+        return target;
+    }
+
+    //新内核在 uart 设备与 tty 之间插入了 serial-base 总线（驱动名 port/ctrl），需向上找到真实驱动
+    std::string driverName(const std::string &device) {
+        char resolved[PATH_MAX];
+        if (realpath(device.c_str(), resolved) == nullptr) {
+            return "";
+        }
+        std::string dir = resolved;
+        while (dir.size() > 12) {
+            std::string target = readLink(dir + "/driver");
+            if (!target.empty() && target.find("/serial-base/") == std::string::npos) {
+                return target.substr(target.rfind('/') + 1);
+            }
+            dir.erase(dir.rfind('/'));
+        }
+        return "";
+    }
+
+    //沿设备路径向上查找 USB 设备节点，读取 VID/PID 等信息
+    void readUsbInfo(const std::string &device, SerialDeviceInfo &info) {
+        char resolved[PATH_MAX];
+        if (realpath(device.c_str(), resolved) == nullptr) {
+            return;
+        }
+        std::string dir = resolved;
+        while (dir.size() > 5) {
+            std::string vid = readAttribute(dir + "/idVendor");
+            if (!vid.empty()) {
+                info.vid = static_cast<uint16_t>(strtoul(vid.c_str(), nullptr, 16));
+                info.pid = static_cast<uint16_t>(strtoul(readAttribute(dir + "/idProduct").c_str(), nullptr, 16));
+                info.manufacturer = readAttribute(dir + "/manufacturer");
+                info.product = readAttribute(dir + "/product");
+                info.serial = readAttribute(dir + "/serial");
+                return;
+            }
+            dir.erase(dir.rfind('/'));
+        }
+    }
+
+    bool sameDevice(const SerialDeviceInfo &lhs, const SerialDeviceInfo &rhs) {
+        return lhs.name == rhs.name && lhs.vid == rhs.vid && lhs.pid == rhs.pid && lhs.serial == rhs.serial;
+    }
+}
+
+SerialEnumerator::SerialEnumerator() {
+    _netlink_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (_netlink_fd >= 0) {
+        struct sockaddr_nl addr{};
+        addr.nl_family = AF_NETLINK;
+        addr.nl_groups = 1; //内核发出的 uevent
+        if (bind(_netlink_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+            ::close(_netlink_fd);
+            _netlink_fd = -1;
+        }
+    }
+    _wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    _devices = scan();
+}
+
+SerialEnumerator::~SerialEnumerator() {
+    stop();
+    if (_netlink_fd >= 0) ::close(_netlink_fd);
+    if (_wakeup_fd >= 0) ::close(_wakeup_fd);
+}
+
+SerialEnumerator &SerialEnumerator::instance() {
+    static SerialEnumerator enumerator;
+    return enumerator;
+}
+
+std::vector<SerialDeviceInfo> SerialEnumerator::scan() {
+    std::vector<SerialDeviceInfo> result;
+    DIR *dir = opendir(SYS_CLASS_TTY);
+    if (dir == nullptr) {
+        return result;
+    }
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != nullptr) {
+        if (ent->d_name[0] == '.') continue;
+        std::string base = std::string(SYS_CLASS_TTY) + "/" + ent->d_name;
+        //虚拟终端、伪终端没有 device 链接
+        std::string device = base + "/device";
+        if (access(device.c_str(), F_OK) != 0) continue;
+        SerialDeviceInfo info;
+        info.name = ent->d_name;
+        info.path = std::string("/dev/") + ent->d_name;
+        //8250 等 uart 驱动会为不存在的端口注册 ttyS*，其 type 为 0(PORT_UNKNOWN)
+        if (readAttribute(base + "/type") == "0") continue;
+        info.driver = driverName(device);
+        readUsbInfo(device, info);
+        result.push_back(std::move(info));
+    }
+    closedir(dir);
+    std::sort(result.begin(), result.end(),
+              [](const SerialDeviceInfo &lhs, const SerialDeviceInfo &rhs) { return lhs.name < rhs.name; });
+    return result;
+}
+
+std::vector<SerialDeviceInfo> SerialEnumerator::devices() {
+    if (_netlink_fd < 0) {
+        refresh();
+    } else {
+        processEvents();
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _devices;
+}
+
+void SerialEnumerator::setHandlers(DeviceHandler onAdded, DeviceHandler onRemoved) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _on_added = std::move(onAdded);
+    _on_removed = std::move(onRemoved);
+}
+
+bool SerialEnumerator::processEvents() {
+    if (!drain()) {
+        return false;
+    }
+    refresh();
+    return true;
+}
+
+void SerialEnumerator::refresh() {
+    uint64_t seq = ++_scan_seq;
+    update(scan(), seq);
+}
+
+bool SerialEnumerator::isMonitoring() const {
+    return _netlink_fd >= 0;
+}
+
+void SerialEnumerator::start() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_running || _netlink_fd < 0 || _wakeup_fd < 0) {
+        return;
+    }
+    _running = true;
+    _worker = std::thread([this] { run(); });
+}
+
+void SerialEnumerator::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_running) return;
+        _running = false;
+    }
+    uint64_t one = 1;
+    ssize_t ret = ::write(_wakeup_fd, &one, sizeof(one));
+    (void) ret;
+    if (_worker.joinable()) _worker.join();
+}
+
+bool SerialEnumerator::drain() {
+    if (_netlink_fd < 0) {
+        return false;
+    }
+    bool tty = false;
+    char buf[8192];
+    for (;;) {
+        ssize_t n = recv(_netlink_fd, buf, sizeof(buf) - 1, MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            //ENOBUFS 表示事件溢出丢失，只能重新扫描
+            if (errno == ENOBUFS) tty = true;
+            break;
+        }
+        if (n == 0) break;
+        buf[n] = 0;
+        //消息为 "action@devpath\0KEY=VALUE\0..."，只关心 SUBSYSTEM=tty
+        for (ssize_t i = 0; i < n; i += static_cast<ssize_t>(strlen(buf + i)) + 1) {
+            if (strcmp(buf + i, "SUBSYSTEM=tty") == 0) {
+                tty = true;
+                break;
+            }
+        }
+    }
+    return tty;
+}
+
+void SerialEnumerator::update(std::vector<SerialDeviceInfo> fresh, uint64_t seq) {
+    std::vector<SerialDeviceInfo> added;
+    std::vector<SerialDeviceInfo> removed;
+    DeviceHandler onAdded;
+    DeviceHandler onRemoved;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (seq < _applied_seq) {
+            return;
+        }
+        _applied_seq = seq;
+        for (auto &device: fresh) {
+            if (std::none_of(_devices.begin(), _devices.end(),
+                             [&](const SerialDeviceInfo &old) { return sameDevice(old, device); })) {
+                added.push_back(device);
+            }
+        }
+        for (auto &device: _devices) {
+            if (std::none_of(fresh.begin(), fresh.end(),
+                             [&](const SerialDeviceInfo &now) { return sameDevice(now, device); })) {
+                removed.push_back(device);
+            }
+        }
+        _devices = std::move(fresh);
+        onAdded = _on_added;
+        onRemoved = _on_removed;
+    }
+    //回调在锁外执行，可在其中调用 devices()
+    if (onRemoved) {
+        for (auto &device: removed) onRemoved(device);
+    }
+    if (onAdded) {
+        for (auto &device: added) onAdded(device);
+    }
+}
+
+void SerialEnumerator::run() {
+    struct pollfd fds[2] = {{_netlink_fd, POLLIN, 0}, {_wakeup_fd, POLLIN, 0}};
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_running) break;
+        }
+        if (poll(fds, 2, -1) < 0 && errno != EINTR) break;
+        if (fds[1].revents & POLLIN) {
+            uint64_t value;
+            while (::read(_wakeup_fd, &value, sizeof(value)) > 0) {}
+        }
+        if (fds[0].revents & POLLIN) {
+            processEvents();
+        }
+    }
+}
@@ -0,0 +1,95 @@
+//
+// @Author: MorningXu
+// @Description: 基于 sysfs 与 uevent 的串口设备枚举，支持热插拔
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SerialDeviceInfo {
+    std::string name;           //ttyUSB0
+    std::string path;           ///dev/ttyUSB0
+    std::string driver;         //ftdi_sio、cp210x、serial8250 ...
+    uint16_t vid = 0;           //USB 厂商id，非 USB 设备为 0
+    uint16_t pid = 0;           //USB 产品id
+    std::string manufacturer;
+    std::string product;
+    std::string serial;         //USB 序列号，可用于固定识别同型号的多个适配器
+};
+
+/**
+ * @brief 串口设备枚举器
+ *
+ * 从 /sys/class/tty 读取真实串口（排除虚拟终端，以及 type 为 0 的 8250 占位端口），结果缓存；
+ * 通过 NETLINK_KOBJECT_UEVENT 感知 tty 设备增删，仅在收到事件后重新扫描。
+ * devices() 会先以非阻塞方式处理积压的事件，因此不启动后台线程也能保持缓存最新；
+ * start() 启动后台线程则可及时触发增删回调。netlink 不可用时 devices() 每次重新扫描。
+ */
+class SerialEnumerator {
+public:
+    using DeviceHandler = std::function<void(const SerialDeviceInfo &)>;
+
+    SerialEnumerator();
+
+    ~SerialEnumerator();
+
+    SerialEnumerator(const SerialEnumerator &) = delete;
+
+    SerialEnumerator &operator=(const SerialEnumerator &) = delete;
+
+    //进程内共享的枚举器
+    static SerialEnumerator &instance();
+
+    //扫描一次 /sys/class/tty，不使用缓存
+    static std::vector<SerialDeviceInfo> scan();
+
+    //当前串口列表
+    std::vector<SerialDeviceInfo> devices();
+
+    //设置设备增删回调，在调用 devices/processEvents 的线程或后台线程中执行
+    void setHandlers(DeviceHandler onAdded, DeviceHandler onRemoved);
+
+    /**
+     * @brief 非阻塞处理积压的 uevent，有 tty 事件时重新扫描并回调
+     * @return 是否发生了重新扫描
+     */
+    bool processEvents();
+
+    //强制重新扫描
+    void refresh();
+
+    //是否已订阅内核 uevent
+    bool isMonitoring() const;
+
+    //启动后台线程等待 uevent
+    void start();
+
+    void stop();
+
+private:
+    bool drain();
+
+    void update(std::vector<SerialDeviceInfo> fresh, uint64_t seq);
+
+    void run();
+
+    int _netlink_fd = -1;
+    int _wakeup_fd = -1;
+    std::mutex _mutex;
+    std::vector<SerialDeviceInfo> _devices;
+    //多个线程同时重新扫描时，丢弃较早开始的扫描结果
+    std::atomic<uint64_t> _scan_seq{0};
+    uint64_t _applied_seq = 0;
+    DeviceHandler _on_added;
+    DeviceHandler _on_removed;
+    std::thread _worker;
+    bool _running = false;
+};
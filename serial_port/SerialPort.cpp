@@ -7,6 +7,15 @@
 */
 
 #include "SerialPort.h"
+#include "SerialEnumerator.h"
+#include "SerialBaud.h"
+
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+#include <cerrno>
+#include <climits>
+#include <cstring>
 
 SerialPort::OpenOptions SerialPort::defaultOptions = {
         true, //        bool autoOpen;
@@ -19,8 +28,54 @@ SerialPort::OpenOptions SerialPort::defaultOptions = {
         false,                  // input xany
         0,                      // c_cc vmin
         50,                     // c_cc vtime
+        SerialPort::LatencyDefault, // latency profile
+        0,                      // frame size
+        0,                      // latency timer
+        0,                      // busy poll
+        0,                      // custom baud rate
 };
 
+namespace {
+    struct BaudRateItem {
+        SerialPort::BaudRate code;
+        unsigned long rate;
+    };
+
+    //标准波特率与 Bxxx 常量的对应关系，BaudRateMake 与 getBaudRate 共用
+    const BaudRateItem BAUD_RATES[] = {
+            {SerialPort::BR50,      50},
+            {SerialPort::BR75,      75},
+            {SerialPort::BR110,     110},
+            {SerialPort::BR134,     134},
+            {SerialPort::BR150,     150},
+            {SerialPort::BR200,     200},
+            {SerialPort::BR300,     300},
+            {SerialPort::BR600,     600},
+            {SerialPort::BR1200,    1200},
+            {SerialPort::BR1800,    1800},
+            {SerialPort::BR2400,    2400},
+            {SerialPort::BR4800,    4800},
+            {SerialPort::BR9600,    9600},
+            {SerialPort::BR19200,   19200},
+            {SerialPort::BR38400,   38400},
+            {SerialPort::BR57600,   57600},
+            {SerialPort::BR115200,  115200},
+            {SerialPort::BR230400,  230400},
+            {SerialPort::BR460800,  460800},
+            {SerialPort::BR500000,  500000},
+            {SerialPort::BR576000,  576000},
+            {SerialPort::BR921600,  921600},
+            {SerialPort::BR1000000, 1000000},
+            {SerialPort::BR1152000, 1152000},
+            {SerialPort::BR1500000, 1500000},
+            {SerialPort::BR2000000, 2000000},
+            {SerialPort::BR2500000, 2500000},
+            {SerialPort::BR3000000, 3000000},
+            {SerialPort::BR3500000, 3500000},
+            {SerialPort::BR4000000, 4000000},
+    };
+}
+
 class OpenOptions;
 
 class OpenOptions;
@@ -34,8 +89,9 @@ SerialPort::SerialPort(std::string path, const OpenOptions options)
 
 
 bool SerialPort::open() {
+    _stats.recordReopen();
     _is_open = open(_path, _open_options);
-    isHealth = _is_open;
+    isHealth = _is_open.load();
     if(isHealth){
         counter = 0;
     }
@@ -55,23 +111,47 @@ bool SerialPort::open(const std::string &path, const OpenOptions &options) {
     * O_RDWR | O_NOCTTY | O_NONBLOCK   非阻塞模式
     */
 
-    _tty_fd = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
-    if (_tty_fd < 0) {
-        _is_open = false;
+    int fd = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
        std::cout<<"开启失败..."<<std::endl;
+       return false;
+    }
+    struct termios tios;
+    termiosOptions(fd, tios, options);
+    tcsetattr(fd, TCSANOW, &tios);// TCSANOW立刻对值进行修改
+    tcflush(fd, TCIOFLUSH); // 清除所有正在发生的I/O数据。
+    if (options.customBaudRate != 0 && !SerialBaud::set(fd, options.customBaudRate)) {
+        //驱动不支持该波特率时不能以 baudRate 的取值继续通信
+        ::close(fd);
+        return false;
+    }
+    applyLatency(fd, path, options);
+    unsigned long actual = SerialBaud::actual(fd);
+    _actual_baud_rate = actual ? actual : configuredBaudRate(options);
+
+    int old = _tty_fd;
+    if (old < 0) {
+        _tty_fd = fd;
     } else {
-        struct termios tios;
-        termiosOptions(tios, options);
-        tcsetattr(_tty_fd, TCSANOW, &tios);// TCSANOW立刻对值进行修改
-        tcflush(_tty_fd, TCIOFLUSH); // 清除所有正在发生的I/O数据。
-        _is_open = true;
+        //dup2 原子地让旧描述符号指向新设备，读线程与事件循环持有的描述符号保持不变，
+        //同时释放旧设备，不再泄漏文件描述符
+        if (dup2(fd, old) < 0) {
+            ::close(fd);
+            return false;
+        }
+        ::close(fd);
     }
-    return _is_open;
+    _is_open = true;
+    return true;
 }
 
 void SerialPort::termiosOptions(termios &tios, const OpenOptions &options) {
+    termiosOptions(_tty_fd, tios, options);
+}
+
+void SerialPort::termiosOptions(int fd, termios &tios, const OpenOptions &options) {
 
-    tcgetattr(_tty_fd, &tios);
+    tcgetattr(fd, &tios);
 
     cfmakeraw(&tios);
     tios.c_cflag &= ~(CSIZE | CRTSCTS);
@@ -117,174 +197,216 @@ void SerialPort::termiosOptions(termios &tios, const OpenOptions &options) {
         }
     }
 
-    tios.c_cc[VMIN] = options.vmin;
-    tios.c_cc[VTIME] = options.vtime;
+    if (options.latency == LatencyLow) {
+        //VMIN=1 且 VTIME=0：有数据即报告可读。VMIN>1 时不足 VMIN 的尾部（长于最短长度的包、
+        //重同步后剩余的字节、一次突发的最后一包）不会唤醒边沿触发的事件循环，要等下一包到达；
+        //VTIME>0 会让驱动按 0.1 秒粒度等待后续字节。frameSize 只作为单次读取长度的参考
+        tios.c_cc[VMIN] = 1;
+        tios.c_cc[VTIME] = 0;
+    } else {
+        tios.c_cc[VMIN] = options.vmin;
+        tios.c_cc[VTIME] = options.vtime;
+    }
+}
+
+void SerialPort::applyLatency(int fd, const std::string &path, const OpenOptions &options) {
+    if (options.latency != LatencyLow) {
+        return;
+    }
+    //8250、部分 USB 串口驱动支持，驱动不支持时忽略
+    struct serial_struct serial{};
+    if (ioctl(fd, TIOCGSERIAL, &serial) == 0) {
+        serial.flags |= ASYNC_LOW_LATENCY;
+        ioctl(fd, TIOCSSERIAL, &serial);
+    }
+    if (options.latencyTimerMs <= 0) {
+        return;
+    }
+    //FTDI 默认每 16 毫秒才把不满 USB 包的数据上送，通过 sysfs 调小，需要写权限
+    char resolved[PATH_MAX];
+    if (realpath(path.c_str(), resolved) == nullptr) {
+        return;
+    }
+    const char *name = strrchr(resolved, '/');
+    std::string timer = std::string("/sys/class/tty/") + (name ? name + 1 : resolved) + "/device/latency_timer";
+    FILE *file = fopen(timer.c_str(), "w");
+    if (file != nullptr) {
+        fprintf(file, "%d", options.latencyTimerMs);
+        fclose(file);
+    }
 }
 
 bool SerialPort::isOpen() const {
     return _is_open;
 }
 
+int SerialPort::fd() const {
+    return _tty_fd;
+}
+
 int SerialPort::write(const void *data, int length) {
-    return ::write(_tty_fd, data, length);
+    int ret = ::write(_tty_fd, data, length);
+    if (ret < 0) checkError(errno);
+    _stats.recordWrite(ret, static_cast<size_t>(length), errno);
+    return ret;
+}
+
+int SerialPort::writev(const struct iovec *iov, int count) {
+    size_t length = 0;
+    for (int i = 0; i < count; i++) length += iov[i].iov_len;
+    int ret = static_cast<int>(::writev(_tty_fd, iov, count));
+    if (ret < 0) checkError(errno);
+    _stats.recordWrite(ret, length, errno);
+    return ret;
+}
+
+int SerialPort::readRaw(void *data, int length, int &err) {
+    int ret = ::read(_tty_fd, data, length);
+    err = ret < 0 ? errno : 0;
+    if (ret < 0 && (err == EAGAIN || err == EWOULDBLOCK) && _open_options.busyPollUs > 0) {
+        //控制回路等待下一包时自旋，省去一次 epoll 唤醒与调度的延迟，超过上限后照常返回 EAGAIN
+        uint64_t deadline = SerialPortStats::nowNs() + static_cast<uint64_t>(_open_options.busyPollUs) * 1000u;
+        do {
+            //让出处理器，与写端共用核心时不会把对方饿死
+            sched_yield();
+            ret = ::read(_tty_fd, data, length);
+            err = ret < 0 ? errno : 0;
+        } while (ret < 0 && (err == EAGAIN || err == EWOULDBLOCK) && SerialPortStats::nowNs() < deadline);
+    }
+    if (ret < 0) checkError(err);
+    _stats.recordRead(ret, err);
+    return ret;
 }
 
 int SerialPort::read(void *data, int length) {
-    return ::read(_tty_fd, data, length);
+    int err;
+    int ret = readRaw(data, length, err);
+    if (_capture != nullptr && ret > 0) {
+        _capture->append(data, static_cast<size_t>(ret), SerialPortStats::nowNs());
+    }
+    return ret;
+}
+
+int SerialPort::read(void *data, int length, uint64_t &timestamp_ns) {
+    int err;
+    int ret = readRaw(data, length, err);
+    timestamp_ns = SerialPortStats::nowNs();
+    if (_capture != nullptr && ret > 0) {
+        _capture->append(data, static_cast<size_t>(ret), timestamp_ns);
+    }
+    return ret;
+}
+
+void SerialPort::completeRead(const void *data, int ret, uint64_t timestamp_ns) {
+    int err = ret < 0 ? -ret : 0;
+    if (ret < 0) checkError(err);
+    _stats.recordRead(ret < 0 ? -1 : ret, err);
+    if (_capture != nullptr && ret > 0) {
+        _capture->append(data, static_cast<size_t>(ret), timestamp_ns);
+    }
+}
+
+void SerialPort::completeWrite(int ret, size_t requested) {
+    int err = ret < 0 ? -ret : 0;
+    if (ret < 0) checkError(err);
+    _stats.recordWrite(ret < 0 ? -1 : ret, requested, err);
+}
+
+const SerialPort::OpenOptions &SerialPort::options() const {
+    return _open_options;
+}
+
+void SerialPort::setCapture(SerialCapture *capture) {
+    _capture = capture;
+}
+
+unsigned long SerialPort::actualBaudRate() const {
+    return _actual_baud_rate;
+}
+
+uint64_t SerialPort::wireTimeNs(size_t bytes) const {
+    unsigned long baud = _actual_baud_rate;
+    if (baud == 0) baud = configuredBaudRate(_open_options);
+    if (baud == 0) {
+        return 0;
+    }
+    //起始位 + 数据位 + 校验位 + 停止位
+    uint64_t bits = 1 + (5 + _open_options.dataBits)
+                    + (_open_options.parity == ParityNone ? 0 : 1)
+                    + (_open_options.stopBits == StopBits2 ? 2 : 1);
+    return bits * bytes * 1000000000ull / static_cast<uint64_t>(baud);
 }
 
 void SerialPort::close() {
-    ::close(_tty_fd);
+    int fd = _tty_fd.exchange(-1);
+    if (fd >= 0) ::close(fd);
     _is_open = false;
 }
 
 SerialPort::BaudRate SerialPort::BaudRateMake(unsigned long baudrate) {
-    switch (baudrate) {
-        case 50:
-            return BR50;
-        case 75:
-            return BR75;
-        case 134:
-            return BR134;
-        case 150:
-            return BR150;
-        case 200:
-            return BR200;
-        case 300:
-            return BR300;
-        case 600:
-            return BR600;
-        case 1200:
-            return BR1200;
-        case 1800:
-            return BR1800;
-        case 2400:
-            return BR2400;
-        case 4800:
-            return BR4800;
-        case 9600:
-            return BR9600;
-        case 19200:
-            return BR19200;
-        case 38400:
-            return BR38400;
-        case 57600:
-            return BR57600;
-        case 115200:
-            return BR115200;
-        case 230400:
-            return BR230400;
-        case 460800:
-            return BR460800;
-        case 500000:
-            return BR500000;
-        case 576000:
-            return BR576000;
-        case 921600:
-            return BR921600;
-        case 1000000:
-            return BR1000000;
-        case 1152000:
-            return BR1152000;
-        case 1500000:
-            return BR1500000;
-        case 2000000:
-            return BR2000000;
-        case 2500000:
-            return BR2500000;
-        case 3000000:
-            return BR3000000;
-        case 3500000:
-            return BR3500000;
-        case 4000000:
-            return BR4000000;
-        default:
-            break;
+    for (auto &item: BAUD_RATES) {
+        if (item.rate == baudrate) return item.code;
     }
     return BR0;
 }
 
 std::vector<std::string> SerialPort::list() {
-    DIR *dir;
-    struct dirent *ent;
-    dir = opendir("/dev");
     std::vector<std::string> ttyList;
-
-    while (ent = readdir(dir), ent != nullptr) {
-        if ("tty" == std::string(ent->d_name).substr(0, 3)) {
-            ttyList.emplace_back(ent->d_name);
-        }
+    for (auto &device: SerialEnumerator::instance().devices()) {
+        ttyList.emplace_back(device.name);
     }
     return ttyList;
 }
 
+unsigned long SerialPort::configuredBaudRate(const OpenOptions &options) {
+    if (options.customBaudRate != 0) {
+        return options.customBaudRate;
+    }
+    return static_cast<unsigned long>(getBaudRate(options.baudRate));
+}
+
 long SerialPort::getBaudRate(int baudRate) {
-    switch (baudRate) {
-        case 1:
-            return 50;
-        case 2:
-            return 75;
-        case 4:
-            return 134;
-        case 5:
-            return 150;
-        case 6:
-            return 200;
-        case 7:
-            return 300;
-        case 8:
-            return 600;
-        case 9:
-            return 1200;
-        case 10:
-            return 1800;
-        case 11:
-            return 2400;
-        case 12:
-            return 4800;
-        case 13:
-            return 9600;
-        case 14:
-            return 19200;
-        case 15:
-            return 38400;
-        case 4097:
-            return 57600;
-        case 4098:
-            return 115200;
-        case 4099:
-            return 230400;
-        case 4100:
-            return 460800;
-        case 4101:
-            return 500000;
-        case 4102:
-            return 576000;
-        case 4103:
-            return 921600;
-        case 4104:
-            return 1000000;
-        case 4105:
-            return 1152000;
-        case 4106:
-            return 1500000;
-        case 4107:
-            return 2000000;
-        case 4108:
-            return 2500000;
-        case 4109:
-            return 3000000;
-        case 4110:
-            return 3500000;
-        case 4111:
-            return 4000000;
-        default:
-            return 0;
+    for (auto &item: BAUD_RATES) {
+        if (item.code == baudRate) return static_cast<long>(item.rate);
     }
+    return 0;
 }
 
 void SerialPort::setCounter(unsigned char counter) {
-    SerialPort::counter = counter;
+    SerialPort::counter.store(counter, std::memory_order_relaxed);
+}
+
+unsigned char SerialPort::getCounter() const {
+    return counter.load(std::memory_order_relaxed);
+}
+
+unsigned char SerialPort::tickCounter() {
+    unsigned char value = counter.load(std::memory_order_relaxed);
+    while (value < 0xff && !counter.compare_exchange_weak(value, value + 1, std::memory_order_relaxed)) {}
+    return value < 0xff ? value + 1 : value;
+}
+
+bool SerialPort::isHealthy() const {
+    return isHealth.load(std::memory_order_relaxed);
+}
+
+void SerialPort::markUnhealthy() {
+    isHealth.store(false, std::memory_order_relaxed);
+}
+
+void SerialPort::checkError(int err) {
+    //设备被拔出或挂断
+    if (err == EIO || err == ENXIO || err == ENODEV || err == EBADF) {
+        isHealth.store(false, std::memory_order_relaxed);
+    }
+}
+
+SerialPortStats &SerialPort::stats() {
+    return _stats;
+}
+
+const SerialPortStats &SerialPort::stats() const {
+    return _stats;
 }
 
 bool operator==(const SerialPort::OpenOptions &lhs, const SerialPort::OpenOptions &rhs) {
@@ -297,7 +419,12 @@ bool operator==(const SerialPort::OpenOptions &lhs, const SerialPort::OpenOption
            && lhs.vtime == rhs.vtime
            && lhs.xon == rhs.xon
            && lhs.xoff == rhs.xoff
-           && lhs.xany == rhs.xany;
+           && lhs.xany == rhs.xany
+           && lhs.latency == rhs.latency
+           && lhs.frameSize == rhs.frameSize
+           && lhs.latencyTimerMs == rhs.latencyTimerMs
+           && lhs.busyPollUs == rhs.busyPollUs
+           && lhs.customBaudRate == rhs.customBaudRate;
 }
 
 bool operator!=(const SerialPort::OpenOptions &lhs, const SerialPort::OpenOptions &rhs) {
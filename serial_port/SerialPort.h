@@ -15,11 +15,15 @@
 #include <unistd.h>  /*Unix 标准函数定义*/
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <string>
 #include <memory>
 #include <iostream>
 #include <dirent.h>
 #include <utility>
+#include <atomic>
+#include "SerialPortStats.h"
+#include "SerialCapture.h"
 
 
 struct termios;
@@ -80,6 +84,11 @@ public:
         ParitySpace
     };
 
+    enum LatencyProfile {
+        LatencyDefault, //按 vmin/vtime 配置，不修改驱动设置
+        LatencyLow      //开启 ASYNC_LOW_LATENCY，VMIN=1 且 VTIME=0，有数据即唤醒
+    };
+
     struct OpenOptions {
         bool autoOpen;
         BaudRate baudRate;
@@ -91,6 +100,11 @@ public:
         bool xany;
         int vmin;
         int vtime;
+        LatencyProfile latency;
+        int frameSize;          //典型数据包长度，仅作为单次读取长度的参考，不影响唤醒时机，0 表示未知
+        int latencyTimerMs;     //LatencyLow：FTDI 等 USB 串口的 latency_timer(毫秒)，0 表示不修改
+        int busyPollUs;         //read 无数据时自旋等待的上限(微秒)，0 表示立即返回
+        unsigned long customBaudRate; //非 0 时通过 termios2/BOTHER 设置任意波特率，忽略 baudRate；设置失败时打开失败
     };
 
     static BaudRate BaudRateMake(unsigned long baudrate);
@@ -98,40 +112,106 @@ public:
     static OpenOptions defaultOptions;
 
     explicit SerialPort(std::string path,OpenOptions options = defaultOptions);
-    //打开串口
+    //打开串口，已打开时以新的文件描述符原子替换旧的，读线程无需停止
     bool open();
 
     bool open(const std::string &path, const OpenOptions &options);
 
     bool isOpen() const;
 
+    //文件描述符，供事件循环注册
+    int fd() const;
+
     //写
     int write(const void *data, int length);
 
+    //分段写，多个片段一次系统调用发出，无需拼接
+    int writev(const struct iovec *iov, int count);
+
     //读
     int read(void *data, int length);
 
+    //读，并记录数据返回时的单调时钟时间(纳秒)，与 SerialPortStats::nowNs 同源
+    int read(void *data, int length, uint64_t &timestamp_ns);
+
+    /**
+     * @brief 记录由外部 I/O 后端（如 SerialUring）完成的读，与 read 一样更新统计、健康状态与录制
+     * @param data 读到的数据
+     * @param ret 读到的字节数，出错时为 -errno
+     * @param timestamp_ns 完成时间，来自 SerialPortStats::nowNs
+     */
+    void completeRead(const void *data, int ret, uint64_t timestamp_ns);
+
+    //记录由外部 I/O 后端完成的写，ret 出错时为 -errno
+    void completeWrite(int ret, size_t requested);
+
+    /**
+     * @brief 录制 read 返回的每个片段，nullptr 关闭录制
+     * 需在读线程开始读之前设置，capture 生命周期需长于录制
+     */
+    void setCapture(SerialCapture *capture);
+
+    //驱动实际设置的波特率（打开时读回），不支持读回时为配置值
+    unsigned long actualBaudRate() const;
+
+    //当前打开参数
+    const OpenOptions &options() const;
+
+    //按当前波特率、数据位、校验位、停止位估算 bytes 个字节在线路上的传输时间(纳秒)
+    uint64_t wireTimeNs(size_t bytes) const;
+
     //串口及监听线程关闭
     void close();
 
+    //真实串口设备名（如 ttyUSB0），详细信息见 SerialEnumerator
     static std::vector<std::string> list();
 
     void setCounter(unsigned char counter);
 
+    unsigned char getCounter() const;
+
+    //计数器加一并返回新值，到 255 后不再增加
+    unsigned char tickCounter();
+
+    //最近一次 read/write 是否未遇到设备级错误(EIO 等)
+    bool isHealthy() const;
+
+    //标记串口失效，等待重连
+    void markUnhealthy();
+
+    //性能计数器，I/O 线程更新，任意线程可调用 stats().snapshot()
+    SerialPortStats &stats();
+
+    const SerialPortStats &stats() const;
+
 protected:
 
     void termiosOptions(termios &tios, const OpenOptions &options);
 
-    long getBaudRate(int baudRate);
+    void termiosOptions(int fd, termios &tios, const OpenOptions &options);
+
+    static long getBaudRate(int baudRate);
+
+    //配置的波特率数值
+    static unsigned long configuredBaudRate(const OpenOptions &options);
 
 private:
+    void checkError(int err);
+
+    int readRaw(void *data, int length, int &err);
+
+    static void applyLatency(int fd, const std::string &path, const OpenOptions &options);
+
     std::string _path;
     OpenOptions _open_options;
-    int _tty_fd{};
-    bool _is_open = false;
+    std::atomic<int> _tty_fd{-1};
+    std::atomic<bool> _is_open{false};
     int _id;
-    bool isHealth = true;
-    unsigned char counter = 0;
+    std::atomic<bool> isHealth{true};
+    std::atomic<unsigned char> counter{0};
+    SerialPortStats _stats;
+    SerialCapture *_capture = nullptr;
+    std::atomic<unsigned long> _actual_baud_rate{0};
 };
 
 bool operator==(const SerialPort::OpenOptions &lhs, const SerialPort::OpenOptions &rhs);
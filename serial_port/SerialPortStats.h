@@ -0,0 +1,273 @@
+//
+// @Author: MorningXu
+// @Description: 串口性能计数器与延迟直方图
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+/**
+ * @brief 对数-线性分桶直方图（HDR 风格），相对误差约 6%
+ *
+ * 小于 16 的值各占一个桶，之后每个 2 的幂区间再均分为 16 个桶。
+ * record 只做几次 relaxed 原子操作，可在 I/O 线程常开；snapshot 可在任意线程调用，不会阻塞记录方。
+ */
+class LogHistogram {
+public:
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr size_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    struct Snapshot {
+        std::array<uint64_t, BUCKETS> counts;
+        uint64_t count;
+        uint64_t sum;
+        uint64_t max;
+
+        /**
+         * @param p 百分位 0~100
+         * @return 该百分位所在桶的上界
+         */
+        uint64_t percentile(double p) const {
+            if (count == 0) return 0;
+            auto rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(count) + 0.5);
+            if (rank == 0) rank = 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKETS; i++) {
+                seen += counts[i];
+                if (seen >= rank) {
+                    uint64_t upper = upperBound(i);
+                    return upper < max ? upper : max;
+                }
+            }
+            return max;
+        }
+
+        double mean() const {
+            return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+        }
+    };
+
+    void record(uint64_t value) {
+        _counts[index(value)].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(value, std::memory_order_relaxed);
+        uint64_t max = _max.load(std::memory_order_relaxed);
+        while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+    }
+
+    Snapshot snapshot() const {
+        Snapshot s{};
+        for (size_t i = 0; i < BUCKETS; i++) {
+            s.counts[i] = _counts[i].load(std::memory_order_relaxed);
+        }
+        s.count = _count.load(std::memory_order_relaxed);
+        s.sum = _sum.load(std::memory_order_relaxed);
+        s.max = _max.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset() {
+        for (auto &c: _counts) c.store(0, std::memory_order_relaxed);
+        _count.store(0, std::memory_order_relaxed);
+        _sum.store(0, std::memory_order_relaxed);
+        _max.store(0, std::memory_order_relaxed);
+    }
+
+    static size_t index(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        int msb = 63 - __builtin_clzll(value);
+        int shift = msb - SUB_BITS;
+        return static_cast<size_t>((shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1)));
+    }
+
+    static uint64_t upperBound(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+        uint64_t sub = index % SUB_BUCKETS;
+        return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> _counts{};
+    std::atomic<uint64_t> _count{0};
+    std::atomic<uint64_t> _sum{0};
+    std::atomic<uint64_t> _max{0};
+};
+
+/**
+ * @brief 单个串口的计数器，全部为 relaxed 原子量，读写线程更新时不加锁
+ */
+class SerialPortStats {
+public:
+    struct Snapshot {
+        uint64_t bytes_in;
+        uint64_t bytes_out;
+        uint64_t reads;
+        uint64_t writes;
+        uint64_t read_errors;
+        uint64_t write_errors;
+        uint64_t eagain;
+        uint64_t short_writes;
+        uint64_t reopen_attempts;
+        uint64_t frames_decoded;
+        uint64_t checksum_failures;
+        uint64_t resync_bytes;
+        LogHistogram::Snapshot read_size;       //每次 read 返回的字节数
+        LogHistogram::Snapshot frame_interval;  //数据包到达间隔(纳秒)
+        LogHistogram::Snapshot frame_span;      //首字节到末字节到达的间隔(纳秒)
+        LogHistogram::Snapshot frame_latency;   //末字节到达至处理完成(纳秒)
+        LogHistogram::Snapshot wire_excess;     //首字节到达至处理完成，超出线路理论传输时间的部分(纳秒)
+    };
+
+    //单调时钟(纳秒)
+    static uint64_t nowNs() {
+        struct timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    /**
+     * @brief 记录一次 read 的结果
+     * @param ret read 返回值
+     * @param err ret 小于 0 时的 errno
+     */
+    void recordRead(long ret, int err) {
+        if (ret > 0) {
+            add(_reads, 1);
+            add(_bytes_in, static_cast<uint64_t>(ret));
+            _read_size.record(static_cast<uint64_t>(ret));
+        } else if (ret < 0) {
+            if (isAgain(err)) add(_eagain, 1);
+            else add(_read_errors, 1);
+        }
+    }
+
+    /**
+     * @brief 记录一次 write/writev 的结果
+     * @param ret 返回值
+     * @param requested 请求写入的字节数
+     * @param err ret 小于 0 时的 errno
+     */
+    void recordWrite(long ret, size_t requested, int err) {
+        if (ret >= 0) {
+            add(_writes, 1);
+            add(_bytes_out, static_cast<uint64_t>(ret));
+            if (static_cast<size_t>(ret) < requested) add(_short_writes, 1);
+        } else if (isAgain(err)) {
+            add(_eagain, 1);
+        } else {
+            add(_write_errors, 1);
+        }
+    }
+
+    void recordReopen() {
+        add(_reopen_attempts, 1);
+    }
+
+    /**
+     * @brief 记录一个数据包到达，用于统计到达间隔
+     * @param now_ns 到达时间，来自 nowNs
+     */
+    void recordFrameArrival(uint64_t now_ns) {
+        uint64_t last = _last_frame_ns.exchange(now_ns, std::memory_order_relaxed);
+        if (last != 0 && now_ns > last) {
+            _frame_interval.record(now_ns - last);
+        }
+    }
+
+    /**
+     * @brief 记录一个数据包的端到端时延，可直接接在 FrameDecoder::setTimingCallback 上：
+     * decoder.setTimingCallback([&](const FrameView &f, uint64_t done) {
+     *     port.stats().recordFrameTiming(f.first_ns, f.last_ns, done, port.wireTimeNs(f.size));
+     * });
+     * @param first_ns 首字节到达时间
+     * @param last_ns 末字节到达时间
+     * @param done_ns 处理完成时间
+     * @param wire_ns 按波特率估算的整包线路传输时间，0 表示不统计
+     */
+    void recordFrameTiming(uint64_t first_ns, uint64_t last_ns, uint64_t done_ns, uint64_t wire_ns = 0) {
+        recordFrameArrival(last_ns);
+        _frame_span.record(last_ns - first_ns);
+        _frame_latency.record(done_ns > last_ns ? done_ns - last_ns : 0);
+        if (wire_ns != 0) {
+            uint64_t total = done_ns > first_ns ? done_ns - first_ns : 0;
+            _wire_excess.record(total > wire_ns ? total - wire_ns : 0);
+        }
+    }
+
+    /**
+     * @brief 同步解码器的累计值，例如 FrameDecoder::frames()/errors()/skippedBytes()
+     */
+    void updateDecoder(uint64_t frames, uint64_t checksum_failures, uint64_t resync_bytes) {
+        _frames_decoded.store(frames, std::memory_order_relaxed);
+        _checksum_failures.store(checksum_failures, std::memory_order_relaxed);
+        _resync_bytes.store(resync_bytes, std::memory_order_relaxed);
+    }
+
+    uint64_t bytesIn() const { return _bytes_in.load(std::memory_order_relaxed); }
+
+    uint64_t readErrors() const { return _read_errors.load(std::memory_order_relaxed); }
+
+    Snapshot snapshot() const {
+        Snapshot s{};
+        s.bytes_in = _bytes_in.load(std::memory_order_relaxed);
+        s.bytes_out = _bytes_out.load(std::memory_order_relaxed);
+        s.reads = _reads.load(std::memory_order_relaxed);
+        s.writes = _writes.load(std::memory_order_relaxed);
+        s.read_errors = _read_errors.load(std::memory_order_relaxed);
+        s.write_errors = _write_errors.load(std::memory_order_relaxed);
+        s.eagain = _eagain.load(std::memory_order_relaxed);
+        s.short_writes = _short_writes.load(std::memory_order_relaxed);
+        s.reopen_attempts = _reopen_attempts.load(std::memory_order_relaxed);
+        s.frames_decoded = _frames_decoded.load(std::memory_order_relaxed);
+        s.checksum_failures = _checksum_failures.load(std::memory_order_relaxed);
+        s.resync_bytes = _resync_bytes.load(std::memory_order_relaxed);
+        s.read_size = _read_size.snapshot();
+        s.frame_interval = _frame_interval.snapshot();
+        s.frame_span = _frame_span.snapshot();
+        s.frame_latency = _frame_latency.snapshot();
+        s.wire_excess = _wire_excess.snapshot();
+        return s;
+    }
+
+private:
+    static bool isAgain(int err) {
+        return err == EAGAIN || err == EWOULDBLOCK;
+    }
+
+    static void add(std::atomic<uint64_t> &counter, uint64_t value) {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    alignas(64) std::atomic<uint64_t> _bytes_in{0};
+    std::atomic<uint64_t> _reads{0};
+    std::atomic<uint64_t> _read_errors{0};
+    std::atomic<uint64_t> _eagain{0};
+    std::atomic<uint64_t> _last_frame_ns{0};
+    std::atomic<uint64_t> _frames_decoded{0};
+    std::atomic<uint64_t> _checksum_failures{0};
+    std::atomic<uint64_t> _resync_bytes{0};
+    //写计数器可能来自其它线程，放在单独的缓存行
+    alignas(64) std::atomic<uint64_t> _bytes_out{0};
+    std::atomic<uint64_t> _writes{0};
+    std::atomic<uint64_t> _write_errors{0};
+    std::atomic<uint64_t> _short_writes{0};
+    std::atomic<uint64_t> _reopen_attempts{0};
+    LogHistogram _read_size;
+    LogHistogram _frame_interval;
+    LogHistogram _frame_span;
+    LogHistogram _frame_latency;
+    LogHistogram _wire_excess;
+};
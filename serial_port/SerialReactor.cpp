@@ -0,0 +1,211 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: 基于 epoll 的多串口事件循环
+* @copyright:
+*/
+
+#include "SerialReactor.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <cerrno>
+
+namespace {
+    const int MAX_EVENTS = 64;
+}
+
+SerialReactor::SerialReactor() {
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    _wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_epoll_fd >= 0 && _wakeup_fd >= 0) {
+        _wakeup.reset(new Entry{EntryWakeup, _wakeup_fd, nullptr, nullptr, nullptr, nullptr, false, false});
+        watch(_wakeup.get(), EPOLLIN | EPOLLET);
+    }
+}
+
+SerialReactor::~SerialReactor() {
+    for (auto &item: _entries) {
+        if (item.second->type == EntryTimer) {
+            ::close(item.first);
+        }
+    }
+    if (_wakeup_fd >= 0) ::close(_wakeup_fd);
+    if (_epoll_fd >= 0) ::close(_epoll_fd);
+}
+
+bool SerialReactor::isValid() const {
+    return _epoll_fd >= 0 && _wakeup_fd >= 0;
+}
+
+bool SerialReactor::add(SerialPort &port, Handler onReadable, Handler onWritable) {
+    if (!port.isOpen() || _entries.count(port.fd())) {
+        return false;
+    }
+    std::unique_ptr<Entry> entry(new Entry{EntryPort, port.fd(), &port, std::move(onReadable),
+                                           std::move(onWritable), nullptr, false, false});
+    if (!watch(entry.get(), portEvents(entry.get()))) {
+        return false;
+    }
+    _entries[port.fd()] = std::move(entry);
+    return true;
+}
+
+bool SerialReactor::remove(SerialPort &port) {
+    auto it = _entries.find(port.fd());
+    if (it == _entries.end() || it->second->type != EntryPort) {
+        return false;
+    }
+    retire(port.fd());
+    return true;
+}
+
+bool SerialReactor::rearm(SerialPort &port) {
+    auto it = _entries.find(port.fd());
+    if (it == _entries.end() || it->second->type != EntryPort) {
+        return false;
+    }
+    Entry *entry = it->second.get();
+    struct epoll_event ev{};
+    ev.events = portEvents(entry);
+    ev.data.ptr = entry;
+    //新设备若已有数据，EPOLL_CTL_ADD 会立即上报一次边沿
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, entry->fd, &ev) == 0) {
+        return true;
+    }
+    return errno == ENOENT && watch(entry, ev.events);
+}
+
+void SerialReactor::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(_post_mutex);
+        _posted.push_back(std::move(task));
+    }
+    wakeup();
+}
+
+int SerialReactor::addTimer(uint64_t interval_ms, TimerHandler handler, bool repeat) {
+    int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (tfd < 0) {
+        return -1;
+    }
+    struct itimerspec spec{};
+    spec.it_value.tv_sec = static_cast<time_t>(interval_ms / 1000);
+    spec.it_value.tv_nsec = static_cast<long>(interval_ms % 1000) * 1000000L;
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+        spec.it_value.tv_nsec = 1;
+    }
+    if (repeat) spec.it_interval = spec.it_value;
+    std::unique_ptr<Entry> entry(new Entry{EntryTimer, tfd, nullptr, nullptr, nullptr,
+                                           std::move(handler), repeat, false});
+    if (timerfd_settime(tfd, 0, &spec, nullptr) < 0 || !watch(entry.get(), EPOLLIN | EPOLLET)) {
+        ::close(tfd);
+        return -1;
+    }
+    _entries[tfd] = std::move(entry);
+    return tfd;
+}
+
+bool SerialReactor::cancelTimer(int id) {
+    auto it = _entries.find(id);
+    if (it == _entries.end() || it->second->type != EntryTimer) {
+        return false;
+    }
+    retire(id);
+    ::close(id);
+    return true;
+}
+
+int SerialReactor::runOnce(int timeout_ms) {
+    struct epoll_event events[MAX_EVENTS];
+    int n = epoll_wait(_epoll_fd, events, MAX_EVENTS, timeout_ms);
+    if (n < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+    for (int i = 0; i < n; i++) {
+        auto *entry = static_cast<Entry *>(events[i].data.ptr);
+        //同一轮中被注销的条目不再分发
+        if (entry->removed) continue;
+        uint32_t ev = events[i].events;
+        switch (entry->type) {
+            case EntryPort:
+                if ((ev & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) && entry->onReadable) {
+                    entry->onReadable(*entry->port);
+                }
+                if ((ev & EPOLLOUT) && !entry->removed && entry->onWritable) {
+                    entry->onWritable(*entry->port);
+                }
+                break;
+            case EntryTimer: {
+                uint64_t expirations;
+                while (::read(entry->fd, &expirations, sizeof(expirations)) > 0) {}
+                if (entry->onTimer) entry->onTimer();
+                if (!entry->repeat && !entry->removed) {
+                    cancelTimer(entry->fd);
+                }
+                break;
+            }
+            case EntryWakeup: {
+                uint64_t value;
+                while (::read(entry->fd, &value, sizeof(value)) > 0) {}
+                runPosted();
+                break;
+            }
+        }
+    }
+    _retired.clear();
+    return n;
+}
+
+void SerialReactor::run() {
+    //不在这里清除停止标记，run 开始之前调用的 stop 不会丢失
+    while (!_stopped) {
+        if (runOnce(-1) < 0) break;
+    }
+}
+
+void SerialReactor::stop() {
+    _stopped = true;
+    wakeup();
+}
+
+bool SerialReactor::watch(Entry *entry, uint32_t events) {
+    struct epoll_event ev{};
+    ev.events = events;
+    ev.data.ptr = entry;
+    return epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, entry->fd, &ev) == 0;
+}
+
+uint32_t SerialReactor::portEvents(const Entry *entry) {
+    uint32_t events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    if (entry->onWritable) events |= EPOLLOUT;
+    return events;
+}
+
+void SerialReactor::wakeup() {
+    uint64_t one = 1;
+    ssize_t ret = ::write(_wakeup_fd, &one, sizeof(one));
+    (void) ret;
+}
+
+void SerialReactor::runPosted() {
+    {
+        std::lock_guard<std::mutex> lock(_post_mutex);
+        _running_posted.swap(_posted);
+    }
+    for (auto &task: _running_posted) {
+        task();
+    }
+    _running_posted.clear();
+}
+
+void SerialReactor::retire(int fd) {
+    auto it = _entries.find(fd);
+    epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    it->second->removed = true;
+    //回调期间可能仍有本轮事件引用该条目，延迟到本轮结束后释放
+    _retired.push_back(std::move(it->second));
+    _entries.erase(it);
+}
@@ -0,0 +1,125 @@
+//
+// @Author: MorningXu
+// @Description: 基于 epoll 的多串口事件循环
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "SerialPort.h"
+
+/**
+ * @brief 单线程服务多个串口的事件循环
+ *
+ * 串口以边沿触发方式注册，空闲串口不消耗 CPU。
+ * 由于是边沿触发，可读回调需要一直 read 到返回 EAGAIN 为止，
+ * 可写回调需要一直 write 到数据写完或返回 EAGAIN 为止。
+ * 串口出错或挂断时同样回调可读处理函数，由 read 的返回值感知错误。
+ */
+class SerialReactor {
+public:
+    using Handler = std::function<void(SerialPort &)>;
+    using TimerHandler = std::function<void()>;
+
+    SerialReactor();
+
+    ~SerialReactor();
+
+    SerialReactor(const SerialReactor &) = delete;
+
+    SerialReactor &operator=(const SerialReactor &) = delete;
+
+    bool isValid() const;
+
+    /**
+     * @brief 注册串口
+     * @param port 已打开的串口，生命周期需长于注册
+     * @param onReadable 可读回调
+     * @param onWritable 可写回调，可为空
+     * @return
+     */
+    bool add(SerialPort &port, Handler onReadable, Handler onWritable = nullptr);
+
+    //注销串口，可在回调中调用
+    bool remove(SerialPort &port);
+
+    /**
+     * @brief 串口文件描述符被替换后（如 SerialSupervisor 重连）重新注册，沿用原有回调
+     *
+     * 旧设备关闭时内核会自动移除其 epoll 注册，需在事件循环线程中调用，跨线程时配合 post 使用
+     */
+    bool rearm(SerialPort &port);
+
+    //投递任务到事件循环线程执行，可跨线程调用
+    void post(std::function<void()> task);
+
+    /**
+     * @brief 添加定时器
+     * @param interval_ms 定时周期(毫秒)
+     * @param handler 定时回调
+     * @param repeat 是否周期触发
+     * @return 定时器id，失败返回-1
+     */
+    int addTimer(uint64_t interval_ms, TimerHandler handler, bool repeat = true);
+
+    //取消定时器，可在回调中调用
+    bool cancelTimer(int id);
+
+    /**
+     * @brief 等待并分发一轮事件
+     * @param timeout_ms 等待超时(毫秒)，-1 表示一直等待
+     * @return 分发的事件数，出错返回-1
+     */
+    int runOnce(int timeout_ms = -1);
+
+    //循环分发事件直到 stop
+    void run();
+
+    //停止事件循环，可跨线程调用；在 run 之前调用时 run 立即返回，停止后不能再次 run
+    void stop();
+
+private:
+    enum EntryType {
+        EntryPort,
+        EntryTimer,
+        EntryWakeup
+    };
+
+    struct Entry {
+        EntryType type;
+        int fd;
+        SerialPort *port;
+        Handler onReadable;
+        Handler onWritable;
+        TimerHandler onTimer;
+        bool repeat;
+        bool removed;
+    };
+
+    bool watch(Entry *entry, uint32_t events);
+
+    static uint32_t portEvents(const Entry *entry);
+
+    void wakeup();
+
+    void runPosted();
+
+    void retire(int fd);
+
+    int _epoll_fd = -1;
+    int _wakeup_fd = -1;
+    std::atomic<bool> _stopped{false};    //stop 已调用，只由 stop 设置
+    std::unordered_map<int, std::unique_ptr<Entry>> _entries;
+    std::vector<std::unique_ptr<Entry>> _retired;
+    std::unique_ptr<Entry> _wakeup;
+    std::mutex _post_mutex;
+    std::vector<std::function<void()>> _posted;
+    std::vector<std::function<void()>> _running_posted;
+};
@@ -0,0 +1,151 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: 录制回放
+* @copyright:
+*/
+
+#include "SerialReplay.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include "SerialPortStats.h"
+
+SerialReplay::SerialReplay(const std::string &prefix, Mode mode) : _mode(mode) {
+    for (unsigned index = 0;; index++) {
+        std::string path = CaptureFormat::segmentPath(prefix, index);
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            break;
+        }
+        struct stat st{};
+        void *map = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= CaptureFormat::FILE_HEADER_SIZE) {
+            map = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            break;
+        }
+        auto *data = static_cast<const unsigned char *>(map);
+        auto size = static_cast<size_t>(st.st_size);
+        uint64_t data_end;
+        memcpy(&data_end, data + CaptureFormat::DATA_END_OFFSET, sizeof(data_end));
+        if (memcmp(data, CaptureFormat::MAGIC, sizeof(CaptureFormat::MAGIC)) != 0) {
+            munmap(map, size);
+            break;
+        }
+        madvise(map, size, MADV_SEQUENTIAL);
+        //录制进程异常退出时文件可能未截断，以 data_end 为准
+        if (data_end > size) data_end = size;
+        _segments.push_back(Segment{data, size, static_cast<size_t>(data_end)});
+        for (size_t offset = CaptureFormat::FILE_HEADER_SIZE;
+             offset + CaptureFormat::RECORD_HEADER_SIZE <= data_end;) {
+            uint32_t len;
+            memcpy(&len, data + offset + 8, sizeof(len));
+            offset += CaptureFormat::recordSize(len);
+            //被截断的记录及其后的数据不会被回放，不计入总量
+            if (offset > data_end) break;
+            _total += len;
+        }
+    }
+    rewind();
+}
+
+SerialReplay::~SerialReplay() {
+    for (auto &segment: _segments) {
+        munmap(const_cast<unsigned char *>(segment.map), segment.size);
+    }
+}
+
+bool SerialReplay::isOpen() const {
+    return !_segments.empty();
+}
+
+int SerialReplay::read(void *data, int length) {
+    uint64_t timestamp_ns;
+    return read(data, length, timestamp_ns);
+}
+
+int SerialReplay::read(void *data, int length, uint64_t &timestamp_ns) {
+    if (length <= 0) {
+        return 0;
+    }
+    if (_chunk_pos == _chunk_size && !nextRecord()) {
+        return 0;
+    }
+    if (_mode == ReplayRealTime) {
+        if (!_started) {
+            _started = true;
+            _first_ts = _chunk_ts;
+            _start_ns = SerialPortStats::nowNs();
+        }
+        uint64_t due = _start_ns + (_chunk_ts - _first_ts);
+        struct timespec ts{};
+        ts.tv_sec = static_cast<time_t>(due / 1000000000ull);
+        ts.tv_nsec = static_cast<long>(due % 1000000000ull);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+        timestamp_ns = due;
+    } else {
+        timestamp_ns = _chunk_ts;
+    }
+    size_t n = _chunk_size - _chunk_pos;
+    if (n > static_cast<size_t>(length)) n = static_cast<size_t>(length);
+    memcpy(data, _chunk + _chunk_pos, n);
+    _chunk_pos += n;
+    _read += n;
+    return static_cast<int>(n);
+}
+
+void SerialReplay::rewind() {
+    _segment = 0;
+    _offset = CaptureFormat::FILE_HEADER_SIZE;
+    _chunk = nullptr;
+    _chunk_size = 0;
+    _chunk_pos = 0;
+    _read = 0;
+    _started = false;
+}
+
+uint64_t SerialReplay::totalBytes() const {
+    return _total;
+}
+
+uint64_t SerialReplay::bytesRead() const {
+    return _read;
+}
+
+bool SerialReplay::nextRecord() {
+    while (_segment < _segments.size()) {
+        const Segment &segment = _segments[_segment];
+        if (_offset + CaptureFormat::RECORD_HEADER_SIZE <= segment.data_end) {
+            const unsigned char *record = segment.map + _offset;
+            uint32_t len;
+            memcpy(&_chunk_ts, record, sizeof(_chunk_ts));
+            memcpy(&len, record + 8, sizeof(len));
+            _offset += CaptureFormat::recordSize(len);
+            if (_offset > segment.data_end) {
+                //记录被截断，跳过本段剩余部分，继续回放下一段
+                _segment++;
+                _offset = CaptureFormat::FILE_HEADER_SIZE;
+                continue;
+            }
+            _chunk = record + CaptureFormat::RECORD_HEADER_SIZE;
+            _chunk_size = len;
+            _chunk_pos = 0;
+            if (len > 0) return true;
+            continue;
+        }
+        _segment++;
+        _offset = CaptureFormat::FILE_HEADER_SIZE;
+    }
+    _chunk_size = 0;
+    _chunk_pos = 0;
+    return false;
+}
@@ -0,0 +1,88 @@
+//
+// @Author: MorningXu
+// @Description: 回放 SerialCapture 录制的数据，接口与 SerialPort 的读一致
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SerialCapture.h"
+
+/**
+ * @brief 录制回放源
+ *
+ * 提供与 SerialPort 相同的 read(void *, int) 与 read(void *, int, uint64_t &)，
+ * 可直接替换串口喂给 FrameDecoder、SpscByteRing::readFrom 等。
+ * 分段文件只读映射，按录制的片段边界返回数据（缓冲区不足时拆分片段）。
+ */
+class SerialReplay {
+public:
+    enum Mode {
+        ReplayRealTime, //按录制的时间间隔回放，read 会睡眠到片段的到达时刻
+        ReplayMaxSpeed  //不等待，尽可能快地回放
+    };
+
+    /**
+     * @param prefix 录制时使用的路径前缀
+     * @param mode 回放模式
+     */
+    explicit SerialReplay(const std::string &prefix, Mode mode = ReplayMaxSpeed);
+
+    ~SerialReplay();
+
+    SerialReplay(const SerialReplay &) = delete;
+
+    SerialReplay &operator=(const SerialReplay &) = delete;
+
+    bool isOpen() const;
+
+    /**
+     * @brief 读
+     * @return 读取的字节数，回放结束返回 0
+     */
+    int read(void *data, int length);
+
+    /**
+     * @brief 读，并给出片段时间戳
+     * 实时模式下为映射到当前单调时钟的到达时间，最快模式下为录制时的原始时间戳
+     */
+    int read(void *data, int length, uint64_t &timestamp_ns);
+
+    //从头回放
+    void rewind();
+
+    //录制的数据总字节数
+    uint64_t totalBytes() const;
+
+    //已回放的字节数
+    uint64_t bytesRead() const;
+
+private:
+    struct Segment {
+        const unsigned char *map;
+        size_t size;
+        size_t data_end;
+    };
+
+    bool nextRecord();
+
+    Mode _mode;
+    std::vector<Segment> _segments;
+    uint64_t _total = 0;
+    uint64_t _read = 0;
+    size_t _segment = 0;
+    size_t _offset = 0;
+    //当前片段
+    const unsigned char *_chunk = nullptr;
+    size_t _chunk_size = 0;
+    size_t _chunk_pos = 0;
+    uint64_t _chunk_ts = 0;
+    //实时回放的时间基准
+    bool _started = false;
+    uint64_t _first_ts = 0;
+    uint64_t _start_ns = 0;
+};
@@ -0,0 +1,145 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: 串口掉线检测与后台重连
+* @copyright:
+*/
+
+#include "SerialSupervisor.h"
+
+#include <poll.h>
+#include <algorithm>
+
+SerialSupervisor::Options SerialSupervisor::defaultOptions = {
+        100,    // checkIntervalMs
+        0,      // silenceTicks
+        100,    // backoffMinMs
+        5000,   // backoffMaxMs
+        0.2,    // jitter
+};
+
+SerialSupervisor::SerialSupervisor(Options options)
+        : _options(options), _rand(std::random_device{}()) {
+}
+
+SerialSupervisor::~SerialSupervisor() {
+    stop();
+}
+
+void SerialSupervisor::watch(SerialPort &port, ReconnectHandler onReconnect) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &w: _watched) {
+        if (w.port == &port) {
+            w.onReconnect = std::move(onReconnect);
+            return;
+        }
+    }
+    _watched.push_back(Watched{&port, std::move(onReconnect), port.stats().bytesIn(), 0,
+                               !port.isOpen(), Clock::now()});
+}
+
+void SerialSupervisor::unwatch(SerialPort &port) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _watched.erase(std::remove_if(_watched.begin(), _watched.end(),
+                                  [&](const Watched &w) { return w.port == &port; }), _watched.end());
+}
+
+void SerialSupervisor::start() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_running) {
+        return;
+    }
+    _running = true;
+    _worker = std::thread([this] { run(); });
+}
+
+void SerialSupervisor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+        _cv.notify_all();
+    }
+    if (_worker.joinable()) _worker.join();
+}
+
+int SerialSupervisor::check() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Clock::time_point now = Clock::now();
+    int count = 0;
+    for (auto &w: _watched) {
+        if (!w.failed && detect(w)) {
+            w.port->markUnhealthy();
+            w.failed = true;
+            w.attempts = 0;
+            w.nextAttempt = now;
+        }
+        if (w.failed && now >= w.nextAttempt && reconnect(w, now)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+uint64_t SerialSupervisor::reconnects() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _reconnects;
+}
+
+bool SerialSupervisor::detect(Watched &watched) {
+    SerialPort &port = *watched.port;
+    if (!port.isOpen() || !port.isHealthy()) {
+        return true;
+    }
+    struct pollfd pfd{port.fd(), POLLIN, 0};
+    if (poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLHUP | POLLERR | POLLNVAL))) {
+        return true;
+    }
+    if (_options.silenceTicks == 0) {
+        return false;
+    }
+    uint64_t bytes = port.stats().bytesIn();
+    if (bytes != watched.lastBytesIn) {
+        watched.lastBytesIn = bytes;
+        port.setCounter(0);
+        return false;
+    }
+    return port.tickCounter() >= _options.silenceTicks;
+}
+
+bool SerialSupervisor::reconnect(Watched &watched, Clock::time_point now) {
+    SerialPort &port = *watched.port;
+    if (!port.open()) {
+        watched.attempts++;
+        watched.nextAttempt = now + backoff(watched.attempts);
+        return false;
+    }
+    watched.failed = false;
+    watched.attempts = 0;
+    watched.lastBytesIn = port.stats().bytesIn();
+    _reconnects++;
+    if (watched.onReconnect) watched.onReconnect(port);
+    return true;
+}
+
+SerialSupervisor::Clock::duration SerialSupervisor::backoff(unsigned attempts) {
+    uint64_t delay = _options.backoffMinMs;
+    for (unsigned i = 1; i < attempts && delay < _options.backoffMaxMs; i++) {
+        delay <<= 1;
+    }
+    delay = std::min<uint64_t>(delay, _options.backoffMaxMs);
+    //随机缩短等待时间，避免多个串口同时重试
+    std::uniform_real_distribution<double> dist(1.0 - _options.jitter, 1.0);
+    return std::chrono::milliseconds(static_cast<uint64_t>(static_cast<double>(delay) * dist(_rand)));
+}
+
+void SerialSupervisor::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_running) {
+        _cv.wait_for(lock, std::chrono::milliseconds(_options.checkIntervalMs));
+        if (!_running) break;
+        lock.unlock();
+        check();
+        lock.lock();
+    }
+}
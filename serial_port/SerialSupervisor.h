@@ -0,0 +1,101 @@
+//
+// @Author: MorningXu
+// @Description: 串口掉线检测与后台重连
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "SerialPort.h"
+
+/**
+ * @brief 串口守护，在后台线程中检测失效串口并按指数退避重连
+ *
+ * 失效判定：read/write 遇到 EIO 等设备错误（SerialPort::isHealthy）、poll 报告 POLLHUP/POLLERR，
+ * 或连续 silenceTicks 个检测周期没有收到数据（用 SerialPort 的 counter 计数，应用也可通过 setCounter(0) 喂狗）。
+ * 重连通过 SerialPort::open() 重新应用保存的 OpenOptions，新描述符以 dup2 原子替换旧描述符，
+ * 读写线程不需要停止也不加锁。注册在 SerialReactor 上的串口需在重连回调中 post 一个 rearm。
+ */
+class SerialSupervisor {
+public:
+    using ReconnectHandler = std::function<void(SerialPort &)>;
+
+    struct Options {
+        uint32_t checkIntervalMs;   //检测周期(毫秒)
+        unsigned char silenceTicks; //连续无数据的检测周期数达到该值视为失效，0 表示不检测
+        uint32_t backoffMinMs;      //首次重连失败后的等待时间(毫秒)
+        uint32_t backoffMaxMs;      //等待时间上限(毫秒)
+        double jitter;              //等待时间随机缩短的最大比例，0~1
+    };
+
+    static Options defaultOptions;
+
+    explicit SerialSupervisor(Options options = defaultOptions);
+
+    ~SerialSupervisor();
+
+    SerialSupervisor(const SerialSupervisor &) = delete;
+
+    SerialSupervisor &operator=(const SerialSupervisor &) = delete;
+
+    /**
+     * @brief 守护串口
+     * @param port 串口，生命周期需长于守护
+     * @param onReconnect 重连成功回调，在守护线程中执行，不能在其中调用 watch/unwatch
+     */
+    void watch(SerialPort &port, ReconnectHandler onReconnect = nullptr);
+
+    void unwatch(SerialPort &port);
+
+    //启动后台线程
+    void start();
+
+    //停止后台线程
+    void stop();
+
+    /**
+     * @brief 执行一轮检测与重连，未 start 时可由外部定时器驱动
+     * @return 本轮重连成功的串口数
+     */
+    int check();
+
+    //累计重连成功次数
+    uint64_t reconnects() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Watched {
+        SerialPort *port;
+        ReconnectHandler onReconnect;
+        uint64_t lastBytesIn;
+        unsigned attempts;
+        bool failed;
+        Clock::time_point nextAttempt;
+    };
+
+    bool detect(Watched &watched);
+
+    bool reconnect(Watched &watched, Clock::time_point now);
+
+    Clock::duration backoff(unsigned attempts);
+
+    void run();
+
+    Options _options;
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<Watched> _watched;
+    std::thread _worker;
+    bool _running = false;
+    uint64_t _reconnects = 0;
+    std::minstd_rand _rand;
+};
@@ -0,0 +1,182 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: 串口发送队列
+* @copyright:
+*/
+
+#include "SerialTxQueue.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+SerialTxQueue::SerialTxQueue(SerialPort &port, size_t capacity, OverflowPolicy policy)
+        : _port(port), _buf(new unsigned char[capacity]), _capacity(capacity), _policy(policy) {
+}
+
+bool SerialTxQueue::push(const void *data, size_t length) {
+    struct iovec iov{const_cast<void *>(data), length};
+    return push(&iov, 1);
+}
+
+bool SerialTxQueue::push(const struct iovec *iov, int count) {
+    size_t length = 0;
+    for (int i = 0; i < count; i++) length += iov[i].iov_len;
+    if (length == 0) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!reserve(lock, length)) {
+        _dropped++;
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        append(iov[i].iov_base, iov[i].iov_len);
+    }
+    _frames.push_back(length);
+    return true;
+}
+
+int SerialTxQueue::flush() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_flushing) {
+        //另一线程正在发送，它的循环会继续带上新入队的数据
+        return 0;
+    }
+    _flushing = true;
+    size_t total = 0;
+    int err = 0;
+    while (_size > 0) {
+        //在锁内取快照，writev 在锁外执行；快照内的字节在写完前不会被移动或覆盖
+        struct iovec iov[2];
+        size_t length = _size;
+        size_t first = _capacity - _head;
+        if (first > length) first = length;
+        iov[0].iov_base = _buf.get() + _head;
+        iov[0].iov_len = first;
+        iov[1].iov_base = _buf.get();
+        iov[1].iov_len = length - first;
+        _inflight = length;
+        lock.unlock();
+        int n = _port.writev(iov, iov[1].iov_len ? 2 : 1);
+        int error = errno;
+        lock.lock();
+        _inflight = 0;
+        if (n < 0) {
+            if (error == EINTR) continue;
+            if (error != EAGAIN && error != EWOULDBLOCK) err = error;
+            break;
+        }
+        if (n == 0) break;
+        size_t written = static_cast<size_t>(n);
+        total += written;
+        _head = (_head + written) % _capacity;
+        _size -= written;
+        //按数据包边界推进，剩余部分记入队首已发送字节数
+        written += _head_sent;
+        while (!_frames.empty() && written >= _frames.front()) {
+            written -= _frames.front();
+            _frames.pop_front();
+        }
+        _head_sent = written;
+        if (static_cast<size_t>(n) < length) break; //部分写，说明内核缓冲区已满，等待下次可写
+    }
+    _flushing = false;
+    if (total > 0) _space.notify_all();
+    if (err != 0) {
+        errno = err;
+        return -1;
+    }
+    return static_cast<int>(total);
+}
+
+size_t SerialTxQueue::pending() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _size;
+}
+
+bool SerialTxQueue::empty() const {
+    return pending() == 0;
+}
+
+uint64_t SerialTxQueue::dropped() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _dropped;
+}
+
+void SerialTxQueue::close() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _closed = true;
+    _space.notify_all();
+}
+
+bool SerialTxQueue::reserve(std::unique_lock<std::mutex> &lock, size_t length) {
+    if (_closed || length > _capacity) {
+        return false;
+    }
+    switch (_policy) {
+        case OverflowBlock:
+            _space.wait(lock, [&] { return _closed || _capacity - _size >= length; });
+            return !_closed;
+        case OverflowDropOldest:
+            return dropOldest(length);
+        case OverflowFail:
+        default:
+            return _capacity - _size >= length;
+    }
+}
+
+bool SerialTxQueue::dropOldest(size_t length) {
+    //部分发送的队首数据包与正在 writev 的数据不能丢弃也不能移动，否则对端会收到半包
+    size_t keep = 0;    //保留的队首数据包数
+    size_t kept = 0;    //保留的待发送字节数
+    while (keep < _frames.size() && ((keep == 0 && _head_sent > 0) || kept < _inflight)) {
+        kept += _frames[keep] - (keep == 0 ? _head_sent : 0);
+        keep++;
+    }
+    size_t drop = 0, bytes = 0;
+    while (_capacity - (_size - bytes) < length && keep + drop < _frames.size()) {
+        bytes += _frames[keep + drop];
+        drop++;
+    }
+    if (_capacity - (_size - bytes) < length) {
+        //全部丢弃也放不下时保留原有数据
+        return false;
+    }
+    if (drop == 0) {
+        return true;
+    }
+    if (keep == 0) {
+        _head = (_head + bytes) % _capacity;
+    } else {
+        //把被丢弃数据包之后的数据前移，接在保留的数据包后面
+        moveWithin((_head + kept) % _capacity, (_head + kept + bytes) % _capacity, _size - kept - bytes);
+    }
+    _frames.erase(_frames.begin() + static_cast<std::ptrdiff_t>(keep),
+                  _frames.begin() + static_cast<std::ptrdiff_t>(keep + drop));
+    _size -= bytes;
+    _dropped += drop;
+    return true;
+}
+
+void SerialTxQueue::moveWithin(size_t to, size_t from, size_t length) {
+    //目标在源之前，按环形缓冲区的连续段从前往后搬
+    while (length > 0) {
+        size_t n = std::min(length, std::min(_capacity - to, _capacity - from));
+        memmove(_buf.get() + to, _buf.get() + from, n);
+        to = (to + n) % _capacity;
+        from = (from + n) % _capacity;
+        length -= n;
+    }
+}
+
+void SerialTxQueue::append(const void *data, size_t length) {
+    size_t tail = (_head + _size) % _capacity;
+    size_t first = _capacity - tail;
+    if (first > length) first = length;
+    memcpy(_buf.get() + tail, data, first);
+    memcpy(_buf.get(), static_cast<const unsigned char *>(data) + first, length - first);
+    _size += length;
+}
@@ -0,0 +1,98 @@
+//
+// @Author: MorningXu
+// @Description: 串口发送队列，合并小包并处理部分写
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sys/uio.h>
+#include "SerialPort.h"
+
+/**
+ * @brief 每个串口一个发送队列
+ *
+ * 生产者 push 的数据包按顺序拷贝进定长环形缓冲区，flush 时以最多两段 writev
+ * 一次发出全部待发送数据，部分写的剩余字节留在队列中，待串口可写时继续发送。
+ * 典型用法是在 SerialReactor 中以 flush 作为可写回调，并在生产者批量 push 后调用一次 flush。
+ */
+class SerialTxQueue {
+public:
+    //队列满时的处理策略
+    enum OverflowPolicy {
+        OverflowBlock,      //阻塞生产者直到有空间
+        OverflowDropOldest, //丢弃最早的未发送数据包，已部分发送或正在发送的数据包保留
+        OverflowFail        //拒绝新数据包
+    };
+
+    /**
+     * @param port 串口
+     * @param capacity 队列容量(字节)
+     * @param policy 队列满时的处理策略
+     */
+    explicit SerialTxQueue(SerialPort &port, size_t capacity = 64 * 1024, OverflowPolicy policy = OverflowFail);
+
+    SerialTxQueue(const SerialTxQueue &) = delete;
+
+    SerialTxQueue &operator=(const SerialTxQueue &) = delete;
+
+    /**
+     * @brief 数据包入队
+     * @param data 数据包
+     * @param length 数据包长度
+     * @return 是否入队成功
+     */
+    bool push(const void *data, size_t length);
+
+    /**
+     * @brief 分段数据包入队，例如 FrameEncoder::segments 生成的片段
+     */
+    bool push(const struct iovec *iov, int count);
+
+    /**
+     * @brief 尽可能多地发送待发送数据，遇到 EAGAIN 时返回
+     * writev 在锁外执行，不阻塞 push；其他线程正在 flush 时直接返回 0
+     * @return 本次写出的字节数，串口错误返回-1
+     */
+    int flush();
+
+    //待发送字节数
+    size_t pending() const;
+
+    bool empty() const;
+
+    //因队列满被丢弃或拒绝的数据包数
+    uint64_t dropped() const;
+
+    //唤醒所有阻塞的生产者，之后的 push 均失败
+    void close();
+
+private:
+    bool reserve(std::unique_lock<std::mutex> &lock, size_t length);
+
+    bool dropOldest(size_t length);
+
+    void moveWithin(size_t to, size_t from, size_t length);
+
+    void append(const void *data, size_t length);
+
+    SerialPort &_port;
+    std::unique_ptr<unsigned char[]> _buf;
+    size_t _capacity;
+    OverflowPolicy _policy;
+    size_t _head = 0;       //已发送位置
+    size_t _size = 0;       //待发送字节数
+    size_t _head_sent = 0;  //队首数据包已发送的字节数
+    size_t _inflight = 0;   //正在锁外 writev 的字节数，从 _head 起算
+    bool _flushing = false;
+    std::deque<size_t> _frames;
+    uint64_t _dropped = 0;
+    bool _closed = false;
+    mutable std::mutex _mutex;
+    std::condition_variable _space;
+};
@@ -0,0 +1,747 @@
+/**
+* @author: MorningXu (morningxu1991@163.com)
+* @version v1.0.0
+* @date: 2026-10-18
+* @brief: 基于 io_uring 的多串口批量读写
+* @copyright:
+*/
+
+#include "SerialUring.h"
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+
+SerialUring::Options SerialUring::defaultOptions = {
+        16,     // maxPorts
+        4096,   // readBufferSize
+        4096,   // writeBufferSize
+        false,  // forceEpoll
+};
+
+namespace {
+    //user_data 低 3 位为请求类型，高位为 Entry 指针
+    enum Op {
+        OpPollIn,
+        OpRead,
+        OpPollOut,
+        OpWrite,
+        OpCancel,
+        OpWakeup
+    };
+
+    const uint64_t OP_MASK = 7;
+
+    //SQ 满且提交失败时的重试次数，之后放弃本次挂载
+    const int SUBMIT_RETRIES = 4;
+
+    int uringSetup(unsigned entries, struct io_uring_params *params) {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int uringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags, const void *arg, size_t size) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, size));
+    }
+
+    int uringRegister(int fd, unsigned opcode, const void *arg, unsigned count) {
+        return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+    }
+
+    template<typename T>
+    T *offset(void *base, uint32_t off) {
+        return reinterpret_cast<T *>(static_cast<unsigned char *>(base) + off);
+    }
+}
+
+/**
+ * @brief io_uring 的共享内存环，不依赖 liburing
+ */
+struct SerialUring::Ring {
+    int fd = -1;
+    struct io_uring_params params{};
+    void *sq = MAP_FAILED;
+    size_t sqSize = 0;
+    void *cq = MAP_FAILED;
+    size_t cqSize = 0;
+    struct io_uring_sqe *sqes = static_cast<struct io_uring_sqe *>(MAP_FAILED);
+    size_t sqesSize = 0;
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    struct io_uring_cqe *cqes = nullptr;
+    unsigned cqMask = 0;
+    unsigned tail = 0;  //本地 SQ 尾，提交时写回内核
+
+    struct Completion {
+        uint64_t userData;
+        int res;
+    };
+
+    std::deque<Completion> backlog;  //为腾出 CQ 而提前取出、尚未分发的完成事件
+
+    ~Ring() {
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (cq != MAP_FAILED && cq != sq) munmap(cq, cqSize);
+        if (sq != MAP_FAILED) munmap(sq, sqSize);
+        if (fd >= 0) ::close(fd);
+    }
+
+    bool map() {
+        sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) sqSize = cqSize = std::max(sqSize, cqSize);
+        sq = mmap(nullptr, sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sq == MAP_FAILED) return false;
+        cq = single ? sq : mmap(nullptr, cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                                IORING_OFF_CQ_RING);
+        if (cq == MAP_FAILED) return false;
+        sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        sqes = static_cast<struct io_uring_sqe *>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                                       MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+        if (sqes == MAP_FAILED) return false;
+        sqHead = offset<unsigned>(sq, params.sq_off.head);
+        sqTail = offset<unsigned>(sq, params.sq_off.tail);
+        sqArray = offset<unsigned>(sq, params.sq_off.array);
+        sqMask = *offset<unsigned>(sq, params.sq_off.ring_mask);
+        cqHead = offset<unsigned>(cq, params.cq_off.head);
+        cqTail = offset<unsigned>(cq, params.cq_off.tail);
+        cqes = offset<struct io_uring_cqe>(cq, params.cq_off.cqes);
+        cqMask = *offset<unsigned>(cq, params.cq_off.ring_mask);
+        tail = *sqTail;
+        return true;
+    }
+
+    //已写入但内核尚未取走的 SQE 数
+    unsigned pending() const {
+        return tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    }
+
+    /**
+     * @brief 保证至少有 count 个空闲 SQE，不足时先把已有的提交给内核，链式请求不会被拆开
+     *
+     * 内核因 CQ 积压(EBUSY)或资源不足(EAGAIN)拒绝提交时，先把 CQ 中的完成事件转存到 backlog
+     * 再重试；仍然失败时返回 false，此时调用方不能再写 SQE，否则会覆盖内核尚未取走的请求。
+     */
+    bool reserve(unsigned count, std::atomic<uint64_t> &syscalls) {
+        for (int attempt = 0; params.sq_entries - pending() < count; attempt++) {
+            if (attempt == SUBMIT_RETRIES) {
+                return false;
+            }
+            syscalls.fetch_add(1, std::memory_order_relaxed);
+            //GETEVENTS 且 min_complete 为 0 不会等待，但会把内核溢出队列中的完成事件刷入 CQ
+            if (uringEnter(fd, pending(), 0, IORING_ENTER_GETEVENTS, nullptr, 0) >= 0 || errno == EINTR) {
+                continue;
+            }
+            if (errno != EBUSY && errno != EAGAIN) {
+                return false;
+            }
+            stash();
+        }
+        return true;
+    }
+
+    //把 CQ 中的完成事件转存到 backlog，由 submitAndWait 按原顺序分发
+    void stash() {
+        unsigned head = *cqHead;
+        unsigned end = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for (; head != end; head++) {
+            const struct io_uring_cqe &cqe = cqes[head & cqMask];
+            backlog.push_back({cqe.user_data, cqe.res});
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    //待分发的完成事件数
+    size_t ready() const {
+        return backlog.size() + (__atomic_load_n(cqTail, __ATOMIC_ACQUIRE) - *cqHead);
+    }
+
+    //取下一个完成事件，转存的先于 CQ 中的；取出即归还 CQE，回调中提交的新请求不会因 CQ 满而受阻
+    bool pop(Completion &completion) {
+        if (!backlog.empty()) {
+            completion = backlog.front();
+            backlog.pop_front();
+            return true;
+        }
+        unsigned head = *cqHead;
+        if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        const struct io_uring_cqe &cqe = cqes[head & cqMask];
+        completion = {cqe.user_data, cqe.res};
+        __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    struct io_uring_sqe *next() {
+        unsigned index = tail & sqMask;
+        struct io_uring_sqe *sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqArray[index] = index;
+        tail++;
+        __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+        return sqe;
+    }
+};
+
+SerialUring::SerialUring(Options options)
+        : _options(options) {
+    _options.maxPorts = std::max(1u, _options.maxPorts);
+    _options.readBufferSize = std::max(1u, _options.readBufferSize);
+    _options.writeBufferSize = std::max(1u, _options.writeBufferSize);
+    _buffers_size = static_cast<size_t>(_options.maxPorts) * (_options.readBufferSize + _options.writeBufferSize);
+    void *buffers = mmap(nullptr, _buffers_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffers == MAP_FAILED) {
+        return;
+    }
+    _buffers = static_cast<unsigned char *>(buffers);
+    for (unsigned slot = _options.maxPorts; slot > 0; slot--) {
+        _free_slots.push_back(slot - 1);
+    }
+    if (_options.forceEpoll || !setupUring()) {
+        setupEpoll();
+    }
+}
+
+SerialUring::~SerialUring() {
+    //先关闭环：内核取消所有未完成请求并解除缓冲区锁定，之后才能释放缓冲区
+    _ring.reset();
+    _reactor.reset();
+    if (_wakeup_fd >= 0) ::close(_wakeup_fd);
+    if (_buffers != nullptr) munmap(_buffers, _buffers_size);
+}
+
+bool SerialUring::isValid() const {
+    if (_buffers == nullptr) {
+        return false;
+    }
+    return _backend == BackendUring ? _ring != nullptr : _reactor != nullptr && _reactor->isValid();
+}
+
+SerialUring::Backend SerialUring::backend() const {
+    return _backend;
+}
+
+bool SerialUring::add(SerialPort &port, ReadHandler onRead) {
+    if (!isValid() || !port.isOpen() || _entries.count(port.fd()) || _free_slots.empty()) {
+        return false;
+    }
+    std::unique_ptr<Entry> entry(new Entry{&port, port.fd(), _free_slots.back(), std::move(onRead), {},
+                                           0, 0, false, false, false, false, 0, 0, 0});
+    Entry *e = entry.get();
+    if (_backend == BackendEpoll) {
+        if (!_reactor->add(port, [this, e](SerialPort &) { readReady(e); },
+                           [this, e](SerialPort &) { flushReady(e); })) {
+            return false;
+        }
+    } else {
+        armRead(e);
+    }
+    _free_slots.pop_back();
+    _entries[port.fd()] = std::move(entry);
+    return true;
+}
+
+bool SerialUring::remove(SerialPort &port) {
+    auto it = _entries.find(port.fd());
+    if (it == _entries.end()) {
+        return false;
+    }
+    if (_backend == BackendEpoll) {
+        _reactor->remove(port);
+    }
+    retire(it->second.get());
+    return true;
+}
+
+bool SerialUring::rearm(SerialPort &port) {
+    auto it = _entries.find(port.fd());
+    if (it == _entries.end()) {
+        return false;
+    }
+    Entry *entry = it->second.get();
+    entry->failed = false;
+    if (_backend == BackendEpoll) {
+        return _reactor->rearm(port);
+    }
+    //挂起的 poll 仍引用被 dup2 替换掉的旧设备，取消后被取消的读会以新设备重新提交
+    if (entry->reading) {
+        cancel(entry);
+    } else {
+        armRead(entry);
+    }
+    return true;
+}
+
+bool SerialUring::write(SerialPort &port, const void *data, size_t length) {
+    auto it = _entries.find(port.fd());
+    if (it == _entries.end()) {
+        return false;
+    }
+    Entry *entry = it->second.get();
+    auto bytes = static_cast<const unsigned char *>(data);
+    entry->queue.insert(entry->queue.end(), bytes, bytes + length);
+    if (_backend == BackendEpoll) {
+        flushReady(entry);
+    } else if (!entry->writing) {
+        fillWrite(entry);
+        armWrite(entry, false);
+    }
+    return true;
+}
+
+void SerialUring::post(std::function<void()> task) {
+    if (_backend == BackendEpoll) {
+        if (_reactor) _reactor->post(std::move(task));
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_post_mutex);
+        _posted.push_back(std::move(task));
+    }
+    wakeup();
+}
+
+int SerialUring::runOnce(int timeout_ms) {
+    int n;
+    if (_backend == BackendEpoll) {
+        _syscalls.fetch_add(1, std::memory_order_relaxed);
+        n = _reactor->runOnce(timeout_ms);
+    } else {
+        n = submitAndWait(timeout_ms);
+    }
+    sweep();
+    return n;
+}
+
+void SerialUring::run() {
+    //不在这里清除停止标记，run 开始之前调用的 stop 不会丢失
+    while (!_stopped) {
+        if (runOnce(-1) < 0) break;
+    }
+}
+
+void SerialUring::stop() {
+    _stopped = true;
+    if (_backend == BackendEpoll) {
+        if (_reactor) _reactor->stop();
+    } else {
+        wakeup();
+    }
+}
+
+uint64_t SerialUring::syscalls() const {
+    return _syscalls.load(std::memory_order_relaxed);
+}
+
+bool SerialUring::setupUring() {
+    unsigned entries = 8;
+    while (entries < _options.maxPorts * 4 + 4) entries <<= 1;
+    std::unique_ptr<Ring> ring(new Ring);
+    ring->fd = uringSetup(entries, &ring->params);
+    if (ring->fd < 0) {
+        return false;
+    }
+    //EXT_ARG(5.11) 用于带超时等待，NODROP 保证完成事件不丢，RW_CUR_POS 允许对串口使用 off=-1
+    const uint32_t required = IORING_FEAT_EXT_ARG | IORING_FEAT_NODROP | IORING_FEAT_RW_CUR_POS;
+    if ((ring->params.features & required) != required || !ring->map()) {
+        return false;
+    }
+    _wakeup_fd = eventfd(0, EFD_CLOEXEC);
+    if (_wakeup_fd < 0) {
+        return false;
+    }
+    std::vector<struct iovec> iov;
+    for (unsigned slot = 0; slot < _options.maxPorts; slot++) {
+        iov.push_back({readBuffer(slot), _options.readBufferSize});
+        iov.push_back({writeBuffer(slot), _options.writeBufferSize});
+    }
+    //锁定内存受 RLIMIT_MEMLOCK 限制，注册失败时仍可使用普通 READ/WRITE
+    _fixed = uringRegister(ring->fd, IORING_REGISTER_BUFFERS, iov.data(), static_cast<unsigned>(iov.size())) == 0;
+    _ring = std::move(ring);
+    _backend = BackendUring;
+    armWakeup();
+    return true;
+}
+
+void SerialUring::setupEpoll() {
+    if (_wakeup_fd >= 0) {
+        ::close(_wakeup_fd);
+        _wakeup_fd = -1;
+    }
+    _backend = BackendEpoll;
+    _reactor.reset(new SerialReactor());
+}
+
+unsigned char *SerialUring::readBuffer(unsigned slot) const {
+    return _buffers + static_cast<size_t>(slot) * _options.readBufferSize;
+}
+
+unsigned char *SerialUring::writeBuffer(unsigned slot) const {
+    return _buffers + static_cast<size_t>(_options.maxPorts) * _options.readBufferSize
+           + static_cast<size_t>(slot) * _options.writeBufferSize;
+}
+
+void SerialUring::armRead(Entry *entry) {
+    entry->reading = true;
+    if (!_ring->reserve(2, _syscalls)) {
+        defer(entry, DeferRead);
+        return;
+    }
+    struct io_uring_sqe *poll = _ring->next();
+    poll->opcode = IORING_OP_POLL_ADD;
+    poll->fd = entry->fd;
+    poll->poll32_events = POLLIN;
+    poll->flags = IOSQE_IO_LINK;
+    poll->user_data = reinterpret_cast<uint64_t>(entry) | OpPollIn;
+
+    struct io_uring_sqe *read = _ring->next();
+    read->opcode = _fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    read->fd = entry->fd;
+    read->addr = reinterpret_cast<uint64_t>(readBuffer(entry->slot));
+    read->len = _options.readBufferSize;
+    read->off = static_cast<uint64_t>(-1);
+    read->buf_index = static_cast<uint16_t>(_fixed ? entry->slot * 2 : 0);
+    read->user_data = reinterpret_cast<uint64_t>(entry) | OpRead;
+
+    entry->inflight += 2;
+}
+
+void SerialUring::armWrite(Entry *entry, bool poll) {
+    entry->writing = true;
+    if (!_ring->reserve(2, _syscalls)) {
+        defer(entry, poll ? DeferWritePoll : DeferWrite);
+        return;
+    }
+    if (poll) {
+        struct io_uring_sqe *sqe = _ring->next();
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = entry->fd;
+        sqe->poll32_events = POLLOUT;
+        sqe->flags = IOSQE_IO_LINK;
+        sqe->user_data = reinterpret_cast<uint64_t>(entry) | OpPollOut;
+        entry->inflight++;
+    }
+    struct io_uring_sqe *write = _ring->next();
+    write->opcode = _fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    write->fd = entry->fd;
+    write->addr = reinterpret_cast<uint64_t>(writeBuffer(entry->slot) + entry->writeOffset);
+    write->len = static_cast<uint32_t>(entry->writeLength - entry->writeOffset);
+    write->off = static_cast<uint64_t>(-1);
+    write->buf_index = static_cast<uint16_t>(_fixed ? entry->slot * 2 + 1 : 0);
+    write->user_data = reinterpret_cast<uint64_t>(entry) | OpWrite;
+    entry->inflight++;
+}
+
+void SerialUring::fillWrite(Entry *entry) {
+    size_t length = std::min<size_t>(entry->queue.size(), _options.writeBufferSize);
+    memcpy(writeBuffer(entry->slot), entry->queue.data(), length);
+    entry->queue.erase(entry->queue.begin(), entry->queue.begin() + static_cast<long>(length));
+    entry->writeLength = length;
+    entry->writeOffset = 0;
+}
+
+void SerialUring::cancel(Entry *entry) {
+    //取消链头的 poll，链上的读写随之以 -ECANCELED 完成；poll 已触发的请求会照常完成
+    if (entry->reading) cancelPoll(entry, true);
+    if (entry->writing) cancelPoll(entry, false);
+}
+
+void SerialUring::cancelPoll(Entry *entry, bool in) {
+    if (!_ring->reserve(1, _syscalls)) {
+        defer(entry, in ? DeferCancelIn : DeferCancelOut);
+        return;
+    }
+    struct io_uring_sqe *sqe = _ring->next();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<uint64_t>(entry) | (in ? OpPollIn : OpPollOut);
+    sqe->user_data = reinterpret_cast<uint64_t>(entry) | OpCancel;
+    entry->inflight++;
+}
+
+void SerialUring::defer(Entry *entry, Deferred op) {
+    //SQ 暂时无法提交，下一轮 submitAndWait 再试；计入 inflight，重试前条目不会被释放
+    if (entry != nullptr) entry->inflight++;
+    _deferred.push_back({entry, op});
+}
+
+void SerialUring::retryDeferred() {
+    if (_deferred.empty()) {
+        return;
+    }
+    std::vector<DeferredOp> ops;
+    ops.swap(_deferred);
+    for (const DeferredOp &deferred: ops) {
+        Entry *entry = deferred.entry;
+        if (entry != nullptr) entry->inflight--;
+        switch (deferred.op) {
+            case DeferRead:
+                if (entry->removed) {
+                    entry->reading = false;
+                } else {
+                    armRead(entry);
+                }
+                break;
+            case DeferWrite:
+            case DeferWritePoll:
+                if (entry->removed) {
+                    entry->writing = false;
+                } else {
+                    armWrite(entry, deferred.op == DeferWritePoll);
+                }
+                break;
+            case DeferCancelIn:
+            case DeferCancelOut:
+                cancelPoll(entry, deferred.op == DeferCancelIn);
+                break;
+            case DeferWakeup:
+                armWakeup();
+                break;
+        }
+    }
+}
+
+void SerialUring::armWakeup() {
+    //eventfd 以阻塞方式创建，io_uring 会在其可读时完成读请求
+    if (!_ring->reserve(1, _syscalls)) {
+        defer(nullptr, DeferWakeup);
+        return;
+    }
+    struct io_uring_sqe *sqe = _ring->next();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = _wakeup_fd;
+    sqe->addr = reinterpret_cast<uint64_t>(&_wakeup_value);
+    sqe->len = sizeof(_wakeup_value);
+    sqe->off = static_cast<uint64_t>(-1);
+    sqe->user_data = OpWakeup;
+}
+
+int SerialUring::submitAndWait(int timeout_ms) {
+    Ring &ring = *_ring;
+    retryDeferred();
+    //仍有挂载失败的请求时不长时间阻塞，尽快再试
+    if (!_deferred.empty() && (timeout_ms < 0 || timeout_ms > 1)) {
+        timeout_ms = 1;
+    }
+    size_t ready = ring.ready();
+    unsigned pending = ring.pending();
+    if (ready == 0 && timeout_ms != 0) {
+        //一次系统调用完成提交与等待
+        struct __kernel_timespec ts{};
+        struct io_uring_getevents_arg arg{};
+        if (timeout_ms > 0) {
+            ts.tv_sec = timeout_ms / 1000;
+            ts.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+            arg.ts = reinterpret_cast<uint64_t>(&ts);
+        }
+        _syscalls.fetch_add(1, std::memory_order_relaxed);
+        int ret = uringEnter(ring.fd, pending, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+        //EBUSY/EAGAIN：CQ 积压或资源暂时不足，未提交的 SQE 留在 SQ 中，分发完成事件后下一轮再提交
+        if (ret < 0 && errno != ETIME && errno != EINTR && errno != EBUSY && errno != EAGAIN) {
+            return -1;
+        }
+    } else if (pending != 0) {
+        _syscalls.fetch_add(1, std::memory_order_relaxed);
+        if (uringEnter(ring.fd, pending, 0, 0, nullptr, 0) < 0 && errno != EINTR && errno != EBUSY
+            && errno != EAGAIN) {
+            return -1;
+        }
+    }
+
+    //只分发本轮开始时已就绪的事件；回调中 reserve 转存的事件仍在其中，顺序不变
+    Ring::Completion completion{};
+    int count = 0;
+    for (size_t budget = ring.ready(); budget > 0 && ring.pop(completion); budget--) {
+        onCompletion(completion.userData, completion.res);
+        count++;
+    }
+    return count;
+}
+
+void SerialUring::onCompletion(uint64_t user_data, int res) {
+    auto op = static_cast<Op>(user_data & OP_MASK);
+    if (op == OpWakeup) {
+        runPosted();
+        armWakeup();
+        return;
+    }
+    auto *entry = reinterpret_cast<Entry *>(user_data & ~OP_MASK);
+    entry->inflight--;
+    switch (op) {
+        case OpPollIn:
+            entry->pollInResult = res;
+            break;
+        case OpPollOut:
+            entry->pollOutResult = res;
+            break;
+        case OpRead:
+            onRead(entry, res);
+            break;
+        case OpWrite:
+            onWrite(entry, res);
+            break;
+        default:
+            break;
+    }
+}
+
+void SerialUring::onRead(Entry *entry, int res) {
+    entry->reading = false;
+    int poll = entry->pollInResult;
+    entry->pollInResult = 0;
+    if (res == -ECANCELED && poll < 0 && poll != -ECANCELED) {
+        res = poll;
+    }
+    //VMIN=0 时没有数据的读返回 0，只有 poll 报告挂断时才是真正的挂断
+    if (res == 0 && !(poll > 0 && (poll & (POLLHUP | POLLERR)))) {
+        res = -EAGAIN;
+    }
+    if (entry->removed) {
+        return;
+    }
+    //-EAGAIN 为虚假唤醒，-ECANCELED 为 rearm 主动取消，-EINTR 为 io-wq 中被打断，均未读到数据，重新挂载即可
+    if (res == -EAGAIN || res == -ECANCELED || res == -EINTR) {
+        armRead(entry);
+        return;
+    }
+    const unsigned char *data = readBuffer(entry->slot);
+    uint64_t now = SerialPortStats::nowNs();
+    entry->port->completeRead(data, res, now);
+    //出错或挂断后 poll 会一直就绪，停止自动读，等待 rearm
+    if (res <= 0) entry->failed = true;
+    if (entry->onRead) entry->onRead(*entry->port, data, res, now);
+    if (!entry->failed && !entry->removed && !entry->reading) {
+        armRead(entry);
+    }
+}
+
+void SerialUring::onWrite(Entry *entry, int res) {
+    entry->writing = false;
+    int poll = entry->pollOutResult;
+    entry->pollOutResult = 0;
+    if (res == -ECANCELED && poll < 0 && poll != -ECANCELED) {
+        res = poll;
+    }
+    if (entry->removed) {
+        return;
+    }
+    //驱动缓冲区已满（或被 rearm 取消），等可写后续发剩余部分
+    if (res == -EAGAIN || res == -ECANCELED) {
+        armWrite(entry, true);
+        return;
+    }
+    //tty 写在 io-wq 中可能被打断，此时一个字节都没有写出，直接重发
+    if (res == -EINTR) {
+        armWrite(entry, false);
+        return;
+    }
+    entry->port->completeWrite(res, entry->writeLength - entry->writeOffset);
+    if (res < 0) {
+        entry->queue.clear();
+        entry->writeLength = entry->writeOffset = 0;
+        return;
+    }
+    entry->writeOffset += static_cast<size_t>(res);
+    if (entry->writeOffset == entry->writeLength) {
+        fillWrite(entry);
+    }
+    if (entry->writeOffset < entry->writeLength) {
+        armWrite(entry, false);
+    }
+}
+
+void SerialUring::readReady(Entry *entry) {
+    //挂断后 epoll 会持续上报 EPOLLHUP，与 io_uring 模式一致，rearm 之前不再读
+    if (entry->failed) {
+        return;
+    }
+    unsigned char *data = readBuffer(entry->slot);
+    for (bool first = true;; first = false) {
+        uint64_t now;
+        int ret = entry->port->read(data, static_cast<int>(_options.readBufferSize), now);
+        int err = ret < 0 ? errno : 0;
+        _syscalls.fetch_add(1, std::memory_order_relaxed);
+        if (ret > 0) {
+            if (entry->onRead) entry->onRead(*entry->port, data, ret, now);
+            if (entry->removed) return;
+            continue;
+        }
+        if (ret < 0 && (err == EAGAIN || err == EWOULDBLOCK)) return;
+        if (ret < 0 && err == EINTR) continue;
+        //VMIN=0 时读完数据返回 0；被唤醒却一个字节都读不到时再确认是否挂断
+        if (ret == 0) {
+            struct pollfd pfd{entry->fd, POLLIN, 0};
+            if (!first || ::poll(&pfd, 1, 0) <= 0 || !(pfd.revents & (POLLHUP | POLLERR))) return;
+        }
+        entry->failed = true;
+        if (entry->onRead) entry->onRead(*entry->port, data, ret < 0 ? -err : 0, now);
+        return;
+    }
+}
+
+void SerialUring::flushReady(Entry *entry) {
+    size_t sent = 0;
+    while (sent < entry->queue.size()) {
+        int ret = entry->port->write(entry->queue.data() + sent, static_cast<int>(entry->queue.size() - sent));
+        int err = ret < 0 ? errno : 0;
+        _syscalls.fetch_add(1, std::memory_order_relaxed);
+        if (ret > 0) {
+            sent += static_cast<size_t>(ret);
+            continue;
+        }
+        if (ret < 0 && err == EINTR) continue;
+        if (ret < 0 && (err == EAGAIN || err == EWOULDBLOCK)) break;
+        sent = entry->queue.size();
+    }
+    entry->queue.erase(entry->queue.begin(), entry->queue.begin() + static_cast<long>(sent));
+}
+
+void SerialUring::retire(Entry *entry) {
+    entry->removed = true;
+    if (_backend == BackendUring) {
+        cancel(entry);
+    }
+    auto it = _entries.find(entry->fd);
+    //回调期间以及未完成的请求仍引用该条目，待请求全部完成后在 sweep 中释放
+    _retired.push_back(std::move(it->second));
+    _entries.erase(it);
+}
+
+void SerialUring::sweep() {
+    for (auto it = _retired.begin(); it != _retired.end();) {
+        if ((*it)->inflight == 0) {
+            _free_slots.push_back((*it)->slot);
+            it = _retired.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void SerialUring::wakeup() {
+    uint64_t one = 1;
+    ssize_t ret = ::write(_wakeup_fd, &one, sizeof(one));
+    (void) ret;
+}
+
+void SerialUring::runPosted() {
+    {
+        std::lock_guard<std::mutex> lock(_post_mutex);
+        _running_posted.swap(_posted);
+    }
+    for (auto &task: _running_posted) {
+        task();
+    }
+    _running_posted.clear();
+}
@@ -0,0 +1,209 @@
+//
+// @Author: MorningXu
+// @Description: 基于 io_uring 的多串口批量读写，不可用时退回 epoll
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "SerialPort.h"
+#include "SerialReactor.h"
+
+/**
+ * @brief 单线程服务多个串口的完成式 I/O 循环
+ *
+ * io_uring 模式下每个串口占用一块注册缓冲区（IORING_REGISTER_BUFFERS），读以
+ * POLL_ADD -> READ_FIXED 链式请求提交：数据到达后由内核直接读入缓冲区，
+ * 一次 io_uring_enter 同时提交所有串口的重新挂载与写请求并收取全部完成事件，
+ * 系统调用次数与串口数、读写次数无关。SerialPort 以 O_NONBLOCK 打开，
+ * io_uring 对非阻塞文件不会自行等待，因此需要先挂 poll。
+ *
+ * 内核不支持 io_uring（或被 io_uring_disabled/seccomp 禁止）时退回 SerialReactor(epoll)，
+ * 接口与回调语义不变。读写结果同样计入 SerialPort::stats() 与录制。
+ *
+ * 除 post、stop 外，所有接口都需在事件循环线程中调用。
+ */
+class SerialUring {
+public:
+    /**
+     * @brief 读完成回调
+     * @param port 串口
+     * @param data 读到的数据，仅在回调期间有效
+     * @param length 字节数；0 表示挂断，小于 0 为 -errno。出错或挂断后不再自动读，重连后调用 rearm
+     * @param timestamp_ns 完成时间，与 SerialPortStats::nowNs 同源
+     */
+    using ReadHandler = std::function<void(SerialPort &port, const unsigned char *data, int length,
+                                           uint64_t timestamp_ns)>;
+
+    enum Backend {
+        BackendUring,
+        BackendEpoll
+    };
+
+    struct Options {
+        unsigned maxPorts;          //最多注册的串口数，决定注册缓冲区个数
+        unsigned readBufferSize;    //每个串口的读缓冲(字节)
+        unsigned writeBufferSize;   //每个串口单次提交的写缓冲(字节)，更多的数据在队列中排队
+        bool forceEpoll;            //不使用 io_uring，便于对比测试
+    };
+
+    static Options defaultOptions;
+
+    explicit SerialUring(Options options = defaultOptions);
+
+    ~SerialUring();
+
+    SerialUring(const SerialUring &) = delete;
+
+    SerialUring &operator=(const SerialUring &) = delete;
+
+    bool isValid() const;
+
+    //实际使用的后端
+    Backend backend() const;
+
+    /**
+     * @brief 注册串口并开始读
+     * @param port 已打开的串口，生命周期需长于注册
+     * @param onRead 读完成回调
+     * @return 串口已注册或超过 maxPorts 时返回 false
+     */
+    bool add(SerialPort &port, ReadHandler onRead);
+
+    //注销串口，可在回调中调用，未发送完的数据丢弃
+    bool remove(SerialPort &port);
+
+    //串口重连或出错后重新开始读，沿用原有回调
+    bool rearm(SerialPort &port);
+
+    /**
+     * @brief 发送数据，数据被拷贝，按调用顺序发出，部分写的剩余部分自动续发
+     * @return 串口未注册时返回 false
+     */
+    bool write(SerialPort &port, const void *data, size_t length);
+
+    //投递任务到事件循环线程执行，可跨线程调用
+    void post(std::function<void()> task);
+
+    /**
+     * @brief 提交待处理请求并分发一轮完成事件
+     * @param timeout_ms 等待超时(毫秒)，-1 表示一直等待
+     * @return 分发的事件数，出错返回-1
+     */
+    int runOnce(int timeout_ms = -1);
+
+    //循环分发事件直到 stop
+    void run();
+
+    //停止事件循环，可跨线程调用；在 run 之前调用时 run 立即返回，停止后不能再次 run
+    void stop();
+
+    //累计 I/O 系统调用次数：io_uring 模式为 io_uring_enter，epoll 模式为 epoll_wait/read/write
+    uint64_t syscalls() const;
+
+private:
+    struct Ring;
+
+    struct Entry {
+        SerialPort *port;
+        int fd;
+        unsigned slot;                      //注册缓冲区下标
+        ReadHandler onRead;
+        std::vector<unsigned char> queue;   //等待拷贝进写缓冲区的数据
+        size_t writeLength;                 //写缓冲区中的数据长度
+        size_t writeOffset;                 //写缓冲区中已写出的长度
+        bool reading;                       //读请求已提交或已推迟
+        bool writing;                       //写请求已提交或已推迟
+        bool failed;                        //读出错或挂断，等待 rearm
+        bool removed;
+        int inflight;                       //尚未收到完成事件的请求数
+        int pollInResult;                   //链头 poll 的结果（就绪事件或 -errno），用于解释随后的读
+        int pollOutResult;
+    };
+
+    //SQ 无法提交时推迟到下一轮的操作
+    enum Deferred {
+        DeferRead,
+        DeferWrite,
+        DeferWritePoll,
+        DeferCancelIn,
+        DeferCancelOut,
+        DeferWakeup
+    };
+
+    struct DeferredOp {
+        Entry *entry;                       //DeferWakeup 时为 nullptr
+        Deferred op;
+    };
+
+    bool setupUring();
+
+    void setupEpoll();
+
+    unsigned char *readBuffer(unsigned slot) const;
+
+    unsigned char *writeBuffer(unsigned slot) const;
+
+    void armRead(Entry *entry);
+
+    void armWrite(Entry *entry, bool poll);
+
+    void fillWrite(Entry *entry);
+
+    void cancel(Entry *entry);
+
+    void cancelPoll(Entry *entry, bool in);
+
+    void defer(Entry *entry, Deferred op);
+
+    void retryDeferred();
+
+    void armWakeup();
+
+    int submitAndWait(int timeout_ms);
+
+    void onCompletion(uint64_t user_data, int res);
+
+    void onRead(Entry *entry, int res);
+
+    void onWrite(Entry *entry, int res);
+
+    void readReady(Entry *entry);
+
+    void flushReady(Entry *entry);
+
+    void retire(Entry *entry);
+
+    void sweep();
+
+    void wakeup();
+
+    void runPosted();
+
+    Options _options;
+    Backend _backend = BackendEpoll;
+    std::unique_ptr<Ring> _ring;
+    std::unique_ptr<SerialReactor> _reactor;
+    unsigned char *_buffers = nullptr;
+    size_t _buffers_size = 0;
+    bool _fixed = false;                    //缓冲区注册成功，使用 READ_FIXED/WRITE_FIXED
+    std::vector<unsigned> _free_slots;
+    std::unordered_map<int, std::unique_ptr<Entry>> _entries;
+    std::vector<std::unique_ptr<Entry>> _retired;
+    std::vector<DeferredOp> _deferred;
+    int _wakeup_fd = -1;
+    uint64_t _wakeup_value = 0;
+    std::atomic<bool> _stopped{false};    //stop 已调用，只由 stop 设置
+    std::atomic<uint64_t> _syscalls{0};
+    std::mutex _post_mutex;
+    std::vector<std::function<void()>> _posted;
+    std::vector<std::function<void()>> _running_posted;
+};
@@ -0,0 +1,91 @@
+//
+// @Author: MorningXu
+// @Description: 数据包校验策略，供编解码器在编译期选择
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Crc16.hpp"
+#include "Crc32c.hpp"
+#include "IsoChecksum.hpp"
+
+namespace lanyueuav {
+    /*
+     * 校验策略约定：
+     * SIZE                          校验码字节数
+     * compute(payload, len, out)    计算数据域的校验码写入 out[0, SIZE)
+     * verify(payload, len)          校验紧跟在数据域之后的 SIZE 字节
+     * 所有方法均为静态内联函数，模板实例化后直接内联进解析循环。
+     */
+
+    /**
+     * @brief ISO(Fletcher) 和校验，与 coderutils::ISOSum 兼容的默认格式
+     */
+    struct IsoSumPolicy {
+        static constexpr size_t SIZE = 2;
+
+        static inline void compute(const unsigned char *payload, size_t len, unsigned char *out) {
+            IsoChecksum::compute(payload, len, out);
+        }
+
+        static inline bool verify(const unsigned char *payload, size_t len) {
+            return IsoChecksum::verify(payload, len);
+        }
+    };
+
+    /**
+     * @brief 8 位累加和，与 coderutils::Sum_data 一致
+     */
+    struct Sum8Policy {
+        static constexpr size_t SIZE = 1;
+
+        static inline unsigned char sum(const unsigned char *payload, size_t len) {
+            unsigned char value = 0;
+            for (size_t i = 0; i < len; i++) {
+                value = static_cast<unsigned char>(value + payload[i]);
+            }
+            return value;
+        }
+
+        static inline void compute(const unsigned char *payload, size_t len, unsigned char *out) {
+            out[0] = sum(payload, len);
+        }
+
+        static inline bool verify(const unsigned char *payload, size_t len) {
+            return sum(payload, len) == payload[len];
+        }
+    };
+
+    /**
+     * @brief CRC16-Modbus，低字节在前，与 StringHex::crc16 一致
+     */
+    struct Crc16ModbusPolicy {
+        static constexpr size_t SIZE = 2;
+
+        static inline void compute(const unsigned char *payload, size_t len, unsigned char *out) {
+            Crc16::store(Crc16::compute(payload, len), out);
+        }
+
+        static inline bool verify(const unsigned char *payload, size_t len) {
+            return Crc16::verify(payload, len + SIZE);
+        }
+    };
+
+    /**
+     * @brief CRC32C，小端存放；编译时开启 SSE4.2 使用硬件指令
+     */
+    struct Crc32cPolicy {
+        static constexpr size_t SIZE = 4;
+
+        static inline void compute(const unsigned char *payload, size_t len, unsigned char *out) {
+            Crc32c::store(Crc32c::compute(payload, len), out);
+        }
+
+        static inline bool verify(const unsigned char *payload, size_t len) {
+            return Crc32c::verify(payload, len);
+        }
+    };
+}
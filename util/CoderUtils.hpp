@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <cstring>
 #include <vector>
 #include "BitConverter.hpp"
+#include "IsoChecksum.hpp"
 
 namespace lanyueuav {
     class coderutils {
@@ -19,8 +21,7 @@ namespace lanyueuav {
          */
         static void bytes2vector(unsigned char *buf, int len, std::vector<unsigned char> &data_array_) {
             //保存接收字节串
-            for (int i = 0; i < len; i++)
-                data_array_.push_back(buf[i]);
+            data_array_.insert(data_array_.end(), buf, buf + len);
         }
 
         /**
@@ -29,15 +30,24 @@ namespace lanyueuav {
          * @return
          */
         static int findHeaderIndex(std::vector<unsigned char> &data_array_) {
-            if (data_array_.size() > 2) {
-                if (data_array_[0] == 0xaa) {
-                    if (data_array_[1] == 0x63) {
-                        return 0;
-                    }
+            if (data_array_.size() <= 2) {
+                return -1;
+            }
+            //包头之后至少还需保留一个字节，与逐字节删除的行为保持一致
+            const unsigned char *base = data_array_.data();
+            size_t limit = data_array_.size() - 2;
+            size_t i = 0;
+            while (i < limit) {
+                auto *hit = static_cast<const unsigned char *>(memchr(base + i, 0xaa, limit - i));
+                if (hit == nullptr) break;
+                i = static_cast<size_t>(hit - base);
+                if (base[i + 1] == 0x63) {
+                    data_array_.erase(data_array_.begin(), data_array_.begin() + i);
+                    return 0;
                 }
-                data_array_.erase(data_array_.begin());
-                return findHeaderIndex(data_array_);
+                i++;
             }
+            data_array_.erase(data_array_.begin(), data_array_.begin() + limit);
             return -1;
         }
 
@@ -61,21 +71,10 @@ namespace lanyueuav {
          * @param startIndex 起始下标
          */
         static void ISOSum(std::vector<unsigned char> &buf, int len, int startIndex) {
-            int32_t k1, k2;
-            int32_t c0 = 0, c1 = 0;
-            unsigned char s1, s0;
-            for (int i = startIndex; i < len + startIndex; ++i) {
-                c0 = c0 + buf[i];
-                c1 = c1 + c0;
-            }
-            k1 = 0xff - ((c0 + c1) % 0xff);
-            k2 = c1;
-            s0 = (unsigned char) (k1 % 0xff);
-            s1 = (unsigned char) (k2 % 0xff);
-            if (s0 == 0) s0 = 0xff;
-            if (s1 == 0) s1 = 0xff;
-            buf.push_back(s0);
-            buf.push_back(s1);
+            unsigned char sum[2];
+            IsoChecksum::compute(buf.data() + startIndex, len, sum);
+            buf.push_back(sum[0]);
+            buf.push_back(sum[1]);
         }
 
         /**
@@ -86,18 +85,12 @@ namespace lanyueuav {
         * @return
         */
         static bool IsISOSum(const std::vector<unsigned char> &buf, int len , int start_index) {
-            int32_t c0 = buf[len + start_index], c1 = buf[len + start_index + 1];
-            if (c0 * c1 != 0) {
-                c0 = 0, c1 = 0;
-                for (int i = 9; i < len + 9; ++i) {
-                    c0 = c0 + buf[i];
-                    c1 = c1 + c0;
-                }
-                if (c0 % 0xff == 0 && c1 % 0xff == 0) {
-                    return true;
-                }
+            if (buf[len + start_index] == 0 || buf[len + start_index + 1] == 0) {
+                return false;
             }
-            return false;
+            IsoChecksum sum;
+            sum.update(buf.data() + start_index, len);
+            return sum.valid();
         }
 
         /**
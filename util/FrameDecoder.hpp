@@ -0,0 +1,278 @@
+//
+// @Author: MorningXu
+// @Description: AA63 协议流式解码状态机
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "ChecksumPolicy.hpp"
+
+namespace lanyueuav {
+    /**
+     * @brief 解码得到的完整数据包视图，指向解码器或调用者的缓冲区，仅在回调期间有效
+     *
+     * 数据包格式：
+     * 0xAA 0x63 | 数据域长(u16 小端) | 发送端簇id | 发送端id | 接收端簇id | 接收端id | 数据域 | 校验码 | 0x09 0xD7
+     * 校验码默认为 2 字节 ISO 和校验，由编解码器的校验策略决定。
+     */
+    struct FrameView {
+        const unsigned char *data;  //整包起始地址（包头）
+        size_t size;                //整包长度
+        uint16_t length;            //数据域长
+        uint8_t sender_group;
+        uint8_t sender_id;
+        uint8_t reciver_group;
+        uint8_t reciver_id;
+        uint64_t first_ns;          //首字节所在片段的到达时间(单调时钟纳秒)，未提供时间戳时为 0
+        uint64_t last_ns;           //末字节所在片段的到达时间
+
+        const unsigned char *payload() const { return data + 8; }
+    };
+
+    /**
+     * @brief 推送式流式解码器
+     *
+     * 可直接喂入 SerialPort::read 得到的任意长度片段，按字节增量解析，
+     * 部分数据不会被重复扫描。整包完整落在输入片段内时回调直接引用输入内存，
+     * 跨片段的数据包在内部组包缓冲区中拼接（每字节只拷贝一次）。
+     * @tparam Policy 校验策略，见 ChecksumPolicy.hpp；常用 FrameDecoder（ISO 和校验）
+     */
+    template<typename Policy>
+    class BasicFrameDecoder {
+    public:
+        static constexpr unsigned char HEADER_0 = 0xaa;
+        static constexpr unsigned char HEADER_1 = 0x63;
+        static constexpr unsigned char END_0 = 0x09;
+        static constexpr unsigned char END_1 = 0xd7;
+        static constexpr size_t HEADER_SIZE = 8;
+        static constexpr size_t CHECKSUM_SIZE = Policy::SIZE;
+        static constexpr size_t END_SIZE = 2;
+        static constexpr size_t OVERHEAD = HEADER_SIZE + CHECKSUM_SIZE + END_SIZE;
+
+        using Callback = std::function<void(const FrameView &)>;
+        //回调返回后调用，done_ns 为回调完成时间，仅对带时间戳的数据包调用
+        using TimingCallback = std::function<void(const FrameView &, uint64_t done_ns)>;
+
+        /**
+         * @param callback 完整数据包回调
+         * @param max_length 允许的最大数据域长，超出视为误同步
+         */
+        explicit BasicFrameDecoder(Callback callback, uint16_t max_length = 0xffff)
+                : _callback(std::move(callback)), _max_length(max_length),
+                  _buf(new unsigned char[max_length + OVERHEAD]) {}
+
+        BasicFrameDecoder(const BasicFrameDecoder &) = delete;
+
+        BasicFrameDecoder &operator=(const BasicFrameDecoder &) = delete;
+
+        /**
+         * @brief 设置时延统计回调，例如转交 SerialPortStats::recordFrameTiming
+         */
+        void setTimingCallback(TimingCallback callback) {
+            _timing = std::move(callback);
+        }
+
+        /**
+         * @brief 喂入接收到的字节
+         * @param data 字节序
+         * @param len 字节序长度
+         * @param timestamp_ns 该片段的到达时间，来自 SerialPort::read 的时间戳重载；0 表示不计时
+         */
+        void push(const unsigned char *data, size_t len, uint64_t timestamp_ns = 0) {
+            _chunk_ns = timestamp_ns;
+            const unsigned char *p = data;
+            size_t n = len;
+            size_t used;
+            while (parse(p, n, used)) {
+                //组包失败：包头之后的字节可能含有真正的包头，需要重新解析
+                //重新解析的字节统一按当前片段计时
+                _scratch.assign(_buf.get() + 1, _buf.get() + _have);
+                _scratch.insert(_scratch.end(), p + used, p + n);
+                _skipped++;
+                _have = 0;
+                _total = 0;
+                _replay.swap(_scratch);
+                p = _replay.data();
+                n = _replay.size();
+            }
+        }
+
+        /**
+         * @brief 丢弃组包中的数据，恢复到查找包头状态
+         */
+        void reset() {
+            _have = 0;
+            _total = 0;
+        }
+
+        /**
+         * @brief 校验以包头开始、长度为 size 的数据包
+         * @param frame 数据包
+         * @param size 整包长度（数据域长 + OVERHEAD）
+         * @return
+         */
+        static bool validate(const unsigned char *frame, size_t size) {
+            if (frame[size - 2] != END_0 || frame[size - 1] != END_1) {
+                return false;
+            }
+            return Policy::verify(frame + HEADER_SIZE, size - OVERHEAD);
+        }
+
+        /**
+         * @brief 根据包头中的数据域长计算整包长度
+         * @param header 至少 4 字节的包头
+         * @return 整包长度
+         */
+        static size_t frameSize(const unsigned char *header) {
+            return (header[2] | (header[3] << 8)) + OVERHEAD;
+        }
+
+        /**
+         * @brief 由已校验的完整数据包构造视图，与校验策略无关
+         * @param frame 数据包
+         * @param size 整包长度
+         */
+        static FrameView view(const unsigned char *frame, size_t size) {
+            FrameView view{};
+            view.data = frame;
+            view.size = size;
+            view.length = static_cast<uint16_t>(frame[2] | (frame[3] << 8));
+            view.sender_group = frame[4];
+            view.sender_id = frame[5];
+            view.reciver_group = frame[6];
+            view.reciver_id = frame[7];
+            return view;
+        }
+
+        /**
+         * @return 成功解码的数据包数
+         */
+        uint64_t frames() const { return _frames; }
+
+        /**
+         * @return 校验或包尾错误的数据包数
+         */
+        uint64_t errors() const { return _errors; }
+
+        /**
+         * @return 重同步累计丢弃的字节数
+         */
+        uint64_t skippedBytes() const { return _skipped; }
+
+    private:
+        /**
+         * @return true 表示组包缓冲区中的数据包校验失败，used 为本次已消费的输入字节数
+         */
+        bool parse(const unsigned char *data, size_t len, size_t &used) {
+            size_t i = 0;
+            while (i < len) {
+                if (_have == 0) {
+                    auto *hit = static_cast<const unsigned char *>(memchr(data + i, HEADER_0, len - i));
+                    if (hit == nullptr) {
+                        _skipped += len - i;
+                        break;
+                    }
+                    size_t h = static_cast<size_t>(hit - data);
+                    _skipped += h - i;
+                    i = h;
+                    size_t avail = len - i;
+                    if (avail >= 2 && data[i + 1] != HEADER_1) {
+                        _skipped++;
+                        i++;
+                        continue;
+                    }
+                    if (avail >= 4) {
+                        size_t size = frameSize(data + i);
+                        if (size - OVERHEAD > _max_length) {
+                            _skipped++;
+                            i++;
+                            continue;
+                        }
+                        if (avail >= size) {
+                            //整包位于输入片段内，直接引用输入内存
+                            if (validate(data + i, size)) {
+                                emit(data + i, size, _chunk_ns);
+                                i += size;
+                            } else {
+                                _errors++;
+                                _skipped++;
+                                i++;
+                            }
+                            continue;
+                        }
+                    }
+                }
+
+                size_t target = _have < 4 ? 4 : _total;
+                if (_have == 0) _first_ns = _chunk_ns;
+                size_t take = target - _have;
+                if (take > len - i) take = len - i;
+                memcpy(_buf.get() + _have, data + i, take);
+                _have += take;
+                i += take;
+
+                if (_total == 0) {
+                    if (_have >= 2 && _buf[1] != HEADER_1) {
+                        used = i;
+                        return true;
+                    }
+                    if (_have == 4) {
+                        _total = frameSize(_buf.get());
+                        if (_total - OVERHEAD > _max_length) {
+                            used = i;
+                            return true;
+                        }
+                    }
+                } else if (_have == _total) {
+                    if (!validate(_buf.get(), _total)) {
+                        _errors++;
+                        used = i;
+                        return true;
+                    }
+                    emit(_buf.get(), _total, _first_ns);
+                    _have = 0;
+                    _total = 0;
+                }
+            }
+            used = len;
+            return false;
+        }
+
+        void emit(const unsigned char *frame, size_t size, uint64_t first_ns) {
+            _frames++;
+            FrameView frame_view = view(frame, size);
+            frame_view.first_ns = first_ns;
+            frame_view.last_ns = _chunk_ns;
+            if (_callback) _callback(frame_view);
+            if (_timing && _chunk_ns != 0) {
+                _timing(frame_view, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count()));
+            }
+        }
+
+        Callback _callback;
+        TimingCallback _timing;
+        uint16_t _max_length;
+        std::unique_ptr<unsigned char[]> _buf;
+        size_t _have = 0;
+        size_t _total = 0;
+        uint64_t _chunk_ns = 0;
+        uint64_t _first_ns = 0;
+        std::vector<unsigned char> _replay;
+        std::vector<unsigned char> _scratch;
+        uint64_t _frames = 0;
+        uint64_t _errors = 0;
+        uint64_t _skipped = 0;
+    };
+
+    //ISO 和校验格式的解码器
+    using FrameDecoder = BasicFrameDecoder<IsoSumPolicy>;
+}
@@ -0,0 +1,235 @@
+//
+// @Author: MorningXu
+// @Description: 按接收端簇id/id 将数据包分发到工作线程
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "FrameDecoder.hpp"
+#include "SpscRing.hpp"
+
+namespace lanyueuav {
+    /**
+     * @brief 数据包分发器
+     *
+     * 读串口的线程对每个解码出的数据包调用 dispatch，按接收端簇id/id 查表找到路由，
+     * 将整包连同到达时间戳拷入该路由的 SpscFrameRing；每个路由一个工作线程调用处理函数。
+     * 慢速的处理函数只会让自己的队列积压并丢包，不会阻塞读串口的线程。
+     * dispatch 只能在一个线程中调用，查表与入队均不分配内存。
+     */
+    class FrameDispatcher {
+    public:
+        using Handler = std::function<void(const FrameView &)>;
+
+        //路由统计
+        struct RouteStats {
+            uint64_t dispatched;  //成功入队的数据包数
+            uint64_t dropped;     //队列满或超长被丢弃的数据包数
+            uint64_t handled;     //处理完成的数据包数
+            size_t backlog;       //当前积压的数据包数
+        };
+
+        FrameDispatcher() {
+            _table.fill(NO_ROUTE);
+        }
+
+        ~FrameDispatcher() {
+            stop();
+        }
+
+        FrameDispatcher(const FrameDispatcher &) = delete;
+
+        FrameDispatcher &operator=(const FrameDispatcher &) = delete;
+
+        /**
+         * @brief 添加路由，需在 start 之前调用
+         * @param handler 处理函数，在该路由的工作线程中执行
+         * @param slots 队列深度，向上取整为 2 的幂
+         * @param slot_size 单个数据包的最大长度
+         * @return 路由编号
+         */
+        int addRoute(Handler handler, size_t slots = 256, size_t slot_size = 256) {
+            _routes.emplace_back(new Route(std::move(handler), slots, slot_size));
+            return static_cast<int>(_routes.size() - 1);
+        }
+
+        /**
+         * @brief 将接收端 reciver_group/reciver_id 绑定到路由
+         */
+        bool bind(uint8_t reciver_group, uint8_t reciver_id, int route) {
+            if (route < 0 || route >= static_cast<int>(_routes.size())) {
+                return false;
+            }
+            _table[key(reciver_group, reciver_id)] = static_cast<int16_t>(route);
+            return true;
+        }
+
+        /**
+         * @brief 将整个接收端簇绑定到路由
+         */
+        bool bindGroup(uint8_t reciver_group, int route) {
+            for (int id = 0; id < 256; id++) {
+                if (!bind(reciver_group, static_cast<uint8_t>(id), route)) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief 未绑定的接收端使用的路由，-1 表示丢弃
+         * @return 路由编号无效时返回 false，默认路由不变
+         */
+        bool setDefaultRoute(int route) {
+            if (route < -1 || route >= static_cast<int>(_routes.size())) {
+                return false;
+            }
+            _default_route = route;
+            return true;
+        }
+
+        //启动所有工作线程
+        void start() {
+            for (auto &route: _routes) {
+                if (route->worker.joinable()) continue;
+                Route *r = route.get();
+                r->running = true;
+                r->worker = std::thread([r] { r->run(); });
+            }
+        }
+
+        //处理完已入队的数据包后停止工作线程
+        void stop() {
+            for (auto &route: _routes) {
+                if (!route->worker.joinable()) continue;
+                route->running = false;
+                route->wake();
+                route->worker.join();
+            }
+        }
+
+        /**
+         * @brief 分发数据包，可直接作为 FrameDecoder 的回调
+         * @return 是否成功入队
+         */
+        bool dispatch(const FrameView &frame) {
+            int index = _table[key(frame.reciver_group, frame.reciver_id)];
+            if (index == NO_ROUTE) index = _default_route;
+            if (index < 0) {
+                _unrouted.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            return _routes[index]->push(frame);
+        }
+
+        RouteStats stats(int route) const {
+            const Route &r = *_routes[route];
+            RouteStats s{};
+            s.dispatched = r.dispatched.load(std::memory_order_relaxed);
+            s.dropped = r.dropped.load(std::memory_order_relaxed);
+            s.handled = r.handled.load(std::memory_order_relaxed);
+            s.backlog = r.ring.size();
+            return s;
+        }
+
+        //没有匹配路由被丢弃的数据包数
+        uint64_t unrouted() const { return _unrouted.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr int16_t NO_ROUTE = -1;
+
+        static size_t key(uint8_t group, uint8_t id) {
+            return (static_cast<size_t>(group) << 8) | id;
+        }
+
+        struct Route {
+            Route(Handler h, size_t slots, size_t size)
+                    : handler(std::move(h)), ring(slots, size + STAMP_SIZE) {}
+
+            bool push(const FrameView &frame) {
+                //槽位开头保存到达时间戳，工作线程据此还原 first_ns/last_ns
+                unsigned char *dst = frame.size + STAMP_SIZE <= ring.slotSize() ? ring.acquire() : nullptr;
+                if (dst == nullptr) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                memcpy(dst, &frame.first_ns, sizeof(uint64_t));
+                memcpy(dst + sizeof(uint64_t), &frame.last_ns, sizeof(uint64_t));
+                memcpy(dst + STAMP_SIZE, frame.data, frame.size);
+                ring.setSize(0, frame.size + STAMP_SIZE);
+                ring.publish();
+                dispatched.fetch_add(1, std::memory_order_relaxed);
+                //发布与读取休眠标记之间需要全屏障，与 run 中的顺序配对
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (sleeping.load(std::memory_order_relaxed)) wake();
+                return true;
+            }
+
+            void run() {
+                int idle = 0;
+                for (;;) {
+                    size_t count = ring.consume([this](const unsigned char *data, size_t size) {
+                        if (!handler) return;
+                        FrameView frame = FrameDecoder::view(data + STAMP_SIZE, size - STAMP_SIZE);
+                        memcpy(&frame.first_ns, data, sizeof(uint64_t));
+                        memcpy(&frame.last_ns, data + sizeof(uint64_t), sizeof(uint64_t));
+                        handler(frame);
+                    }, BATCH);
+                    if (count > 0) {
+                        handled.fetch_add(count, std::memory_order_relaxed);
+                        idle = 0;
+                        continue;
+                    }
+                    if (!running) break;
+                    if (++idle < 64) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    //先声明休眠再复查队列，避免与生产者的唤醒错过
+                    std::unique_lock<std::mutex> lock(mutex);
+                    sleeping.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (ring.empty() && running) {
+                        cv.wait_for(lock, std::chrono::milliseconds(10));
+                    }
+                    sleeping.store(false, std::memory_order_relaxed);
+                }
+            }
+
+            void wake() {
+                std::lock_guard<std::mutex> lock(mutex);
+                cv.notify_one();
+            }
+
+            static constexpr size_t BATCH = 64;
+            static constexpr size_t STAMP_SIZE = 2 * sizeof(uint64_t);
+
+            Handler handler;
+            SpscFrameRing ring;
+            alignas(64) std::atomic<uint64_t> dispatched{0};
+            std::atomic<uint64_t> dropped{0};
+            alignas(64) std::atomic<uint64_t> handled{0};
+            std::atomic<bool> sleeping{false};
+            std::atomic<bool> running{false};
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::thread worker;
+        };
+
+        std::array<int16_t, 65536> _table{};
+        std::vector<std::unique_ptr<Route>> _routes;
+        int _default_route = -1;
+        std::atomic<uint64_t> _unrouted{0};
+    };
+}
@@ -0,0 +1,177 @@
+//
+// @Author: MorningXu
+// @Description: AA63 协议零分配编码
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <sys/uio.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "BitConverter.hpp"
+#include "ChecksumPolicy.hpp"
+#include "FrameDecoder.hpp"
+
+namespace lanyueuav {
+    /**
+     * @brief 分段发送用的数据包片段，包头/数据域/校验+包尾三段，数据域不拷贝
+     *
+     * iov 指向本结构体内部的 head/tail，结构体移动后需重新调用 FrameEncoder::segments。
+     */
+    template<typename Policy>
+    struct BasicFrameSegments {
+        unsigned char head[BasicFrameDecoder<Policy>::HEADER_SIZE];
+        unsigned char tail[BasicFrameDecoder<Policy>::CHECKSUM_SIZE + BasicFrameDecoder<Policy>::END_SIZE];
+        struct iovec iov[3];
+
+        size_t size() const { return iov[0].iov_len + iov[1].iov_len + iov[2].iov_len; }
+    };
+
+    /**
+     * @brief 数据包编码，按数据域长一次性确定整包大小，单次遍历写入调用者提供的缓冲区
+     * @tparam Policy 校验策略，需与对端解码器一致；常用 FrameEncoder（ISO 和校验）
+     */
+    template<typename Policy>
+    class BasicFrameEncoder {
+        using Decoder = BasicFrameDecoder<Policy>;
+
+    public:
+        using Segments = BasicFrameSegments<Policy>;
+
+        /**
+         * @param len 数据域长
+         * @return 整包长度
+         */
+        static constexpr size_t frameSize(uint16_t len) {
+            return len + Decoder::OVERHEAD;
+        }
+
+        /**
+         * @brief 写入 8 字节包头，与 coderutils::header_encode 格式相同
+         */
+        static void writeHeader(unsigned char *out, uint16_t len, uint8_t sender_group, uint8_t sender_id,
+                                uint8_t reciver_group, uint8_t reciver_id) {
+            out[0] = Decoder::HEADER_0;
+            out[1] = Decoder::HEADER_1;
+            BitConverter::write<Endian::Little>(len, out + 2);
+            out[4] = sender_group;
+            out[5] = sender_id;
+            out[6] = reciver_group;
+            out[7] = reciver_id;
+        }
+
+        /**
+         * @brief 根据数据域写入校验码与包尾
+         * @param out Policy::SIZE + 2 字节输出
+         * @param payload 数据域
+         * @param len 数据域长
+         */
+        static void writeTail(unsigned char *out, const unsigned char *payload, uint16_t len) {
+            Policy::compute(payload, len, out);
+            out[Policy::SIZE] = Decoder::END_0;
+            out[Policy::SIZE + 1] = Decoder::END_1;
+        }
+
+        /**
+         * @brief 编码整包
+         * @param out 输出缓冲
+         * @param capacity 输出缓冲大小
+         * @param payload 数据域
+         * @param len 数据域长
+         * @return 整包长度，缓冲区不足返回 0
+         */
+        static size_t encode(unsigned char *out, size_t capacity, const unsigned char *payload, uint16_t len,
+                             uint8_t sender_group, uint8_t sender_id, uint8_t reciver_group, uint8_t reciver_id) {
+            size_t size = frameSize(len);
+            if (capacity < size) {
+                return 0;
+            }
+            writeHeader(out, len, sender_group, sender_id, reciver_group, reciver_id);
+            memcpy(out + Decoder::HEADER_SIZE, payload, len);
+            writeTail(out + Decoder::HEADER_SIZE + len, out + Decoder::HEADER_SIZE, len);
+            return size;
+        }
+
+        /**
+         * @brief 编码整包到 vector，只调整一次大小；复用同一个 vector 时不再分配内存
+         */
+        static size_t encode(std::vector<unsigned char> &out, const unsigned char *payload, uint16_t len,
+                             uint8_t sender_group, uint8_t sender_id, uint8_t reciver_group, uint8_t reciver_id) {
+            out.resize(frameSize(len));
+            return encode(out.data(), out.size(), payload, len, sender_group, sender_id, reciver_group, reciver_id);
+        }
+
+        /**
+         * @brief 生成分段发送描述，配合 SerialPort::writev 发送，数据域不拷贝
+         * @param seg 片段
+         * @param payload 数据域，发送完成前需保持有效
+         * @param len 数据域长
+         */
+        static void segments(Segments &seg, const unsigned char *payload, uint16_t len,
+                             uint8_t sender_group, uint8_t sender_id, uint8_t reciver_group, uint8_t reciver_id) {
+            writeHeader(seg.head, len, sender_group, sender_id, reciver_group, reciver_id);
+            writeTail(seg.tail, payload, len);
+            seg.iov[0].iov_base = seg.head;
+            seg.iov[0].iov_len = sizeof(seg.head);
+            seg.iov[1].iov_base = const_cast<unsigned char *>(payload);
+            seg.iov[1].iov_len = len;
+            seg.iov[2].iov_base = seg.tail;
+            seg.iov[2].iov_len = sizeof(seg.tail);
+        }
+    };
+
+    /**
+     * @brief 原地构建数据包：先取得数据域指针直接写字段，再 finish 补齐校验与包尾
+     *
+     * 示例：
+     * FrameBuilder builder(buf, sizeof(buf), 12, 1, 2, 3, 4);
+     * BitConverter::write<Endian::Little>(value, builder.payload());
+     * serial.write(builder.data(), builder.finish());
+     */
+    template<typename Policy>
+    class BasicFrameBuilder {
+        using Encoder = BasicFrameEncoder<Policy>;
+
+    public:
+        BasicFrameBuilder(unsigned char *out, size_t capacity, uint16_t len, uint8_t sender_group,
+                          uint8_t sender_id, uint8_t reciver_group, uint8_t reciver_id)
+                : _out(capacity >= Encoder::frameSize(len) ? out : nullptr), _len(len) {
+            if (_out != nullptr) {
+                Encoder::writeHeader(_out, len, sender_group, sender_id, reciver_group, reciver_id);
+            }
+        }
+
+        //缓冲区是否足够容纳整包
+        bool isValid() const { return _out != nullptr; }
+
+        unsigned char *data() const { return _out; }
+
+        unsigned char *payload() const { return _out + BasicFrameDecoder<Policy>::HEADER_SIZE; }
+
+        uint16_t length() const { return _len; }
+
+        /**
+         * @brief 写入校验码与包尾
+         * @return 整包长度，缓冲区不足返回 0
+         */
+        size_t finish() {
+            if (_out == nullptr) {
+                return 0;
+            }
+            Encoder::writeTail(payload() + _len, payload(), _len);
+            return Encoder::frameSize(_len);
+        }
+
+    private:
+        unsigned char *_out;
+        uint16_t _len;
+    };
+
+    //ISO 和校验格式
+    using FrameSegments = BasicFrameSegments<IsoSumPolicy>;
+    using FrameEncoder = BasicFrameEncoder<IsoSumPolicy>;
+    using FrameBuilder = BasicFrameBuilder<IsoSumPolicy>;
+}
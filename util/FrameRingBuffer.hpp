@@ -0,0 +1,167 @@
+//
+// @Author: MorningXu
+// @Description: 定长环形接收缓冲区，负责 0xAA 0x63 包头重同步
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace lanyueuav {
+    /**
+     * @brief 定长环形接收缓冲区
+     *
+     * 容量在构造时向上取整为 2 的幂并一次性分配，之后只移动读写游标，
+     * 不搬移数据也不重新分配内存。包头查找使用 memchr 扫描连续段，
+     * 丢弃的噪声字节计入 skippedBytes()。
+     */
+    class FrameRingBuffer {
+    public:
+        static constexpr unsigned char HEADER_0 = 0xaa;
+        static constexpr unsigned char HEADER_1 = 0x63;
+
+        explicit FrameRingBuffer(size_t capacity = 1u << 17) {
+            size_t cap = 1;
+            while (cap < capacity) cap <<= 1;
+            _capacity = cap;
+            _mask = cap - 1;
+            _buf.reset(new unsigned char[cap]);
+        }
+
+        FrameRingBuffer(const FrameRingBuffer &) = delete;
+
+        FrameRingBuffer &operator=(const FrameRingBuffer &) = delete;
+
+        size_t capacity() const { return _capacity; }
+
+        /**
+         * @return 当前可读字节数
+         */
+        size_t size() const { return _write - _read; }
+
+        /**
+         * @return 当前剩余空间
+         */
+        size_t space() const { return _capacity - size(); }
+
+        bool empty() const { return _write == _read; }
+
+        /**
+         * @brief 写入字节，空间不足时只写入能容纳的部分
+         * @param data 数据
+         * @param len 数据长度
+         * @return 实际写入的字节数
+         */
+        size_t push(const unsigned char *data, size_t len) {
+            if (len > space()) len = space();
+            size_t pos = _write & _mask;
+            size_t first = _capacity - pos;
+            if (first > len) first = len;
+            memcpy(_buf.get() + pos, data, first);
+            memcpy(_buf.get(), data + first, len - first);
+            _write += len;
+            return len;
+        }
+
+        /**
+         * @brief 获取可直接写入的连续空闲区，配合 SerialPort::read 免拷贝接收
+         * @param len 输出连续空闲区长度
+         * @return 空闲区起始地址
+         */
+        unsigned char *writeRegion(size_t &len) {
+            size_t pos = _write & _mask;
+            size_t first = _capacity - pos;
+            len = space() < first ? space() : first;
+            return _buf.get() + pos;
+        }
+
+        /**
+         * @brief 提交通过 writeRegion 写入的字节
+         * @param n 写入字节数
+         */
+        void commit(size_t n) { _write += n; }
+
+        /**
+         * @brief 读取第 i 个可读字节（相对读游标）
+         */
+        unsigned char at(size_t i) const { return _buf[(_read + i) & _mask]; }
+
+        /**
+         * @brief 拷贝出数据但不移动读游标
+         * @param out 输出缓冲
+         * @param offset 相对读游标的偏移
+         * @param len 拷贝长度
+         * @return 实际拷贝的字节数
+         */
+        size_t peek(unsigned char *out, size_t offset, size_t len) const {
+            if (offset >= size()) return 0;
+            if (len > size() - offset) len = size() - offset;
+            size_t pos = (_read + offset) & _mask;
+            size_t first = _capacity - pos;
+            if (first > len) first = len;
+            memcpy(out, _buf.get() + pos, first);
+            memcpy(out + first, _buf.get(), len - first);
+            return len;
+        }
+
+        /**
+         * @brief 丢弃 n 个可读字节
+         */
+        void consume(size_t n) {
+            if (n > size()) n = size();
+            _read += n;
+        }
+
+        /**
+         * @brief 查找包头，包头之前的字节被丢弃并计入跳过计数
+         *
+         * 若最后一个字节为 0xAA，则保留该字节等待后续数据。
+         * @return 0 包头位于读游标处；-1 未找到完整包头
+         */
+        int findHeader() {
+            while (size() >= 2) {
+                size_t pos = _read & _mask;
+                size_t seg = _capacity - pos;
+                if (seg > size()) seg = size();
+                const unsigned char *base = _buf.get() + pos;
+                auto *hit = static_cast<const unsigned char *>(memchr(base, HEADER_0, seg));
+                if (hit == nullptr) {
+                    drop(seg);
+                    continue;
+                }
+                drop(static_cast<size_t>(hit - base));
+                if (size() < 2) break;
+                if (at(1) == HEADER_1) return 0;
+                drop(1);
+            }
+            if (size() == 1 && at(0) != HEADER_0) drop(1);
+            return -1;
+        }
+
+        /**
+         * @return 重同步累计丢弃的字节数
+         */
+        uint64_t skippedBytes() const { return _skipped; }
+
+        void resetSkippedBytes() { _skipped = 0; }
+
+        void clear() { _read = _write; }
+
+    private:
+        void drop(size_t n) {
+            _read += n;
+            _skipped += n;
+        }
+
+        std::unique_ptr<unsigned char[]> _buf;
+        size_t _capacity;
+        size_t _mask;
+        size_t _read = 0;
+        size_t _write = 0;
+        uint64_t _skipped = 0;
+    };
+}
@@ -0,0 +1,156 @@
+//
+// @Author: MorningXu
+// @Description: ISO(Fletcher) 和校验增量计算
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SSSE3__
+#include <immintrin.h>
+#endif
+
+namespace lanyueuav {
+    /**
+     * @brief ISO 和校验，与 coderutils::ISOSum 结果一致
+     *
+     * c0 为字节累加和，c1 为 c0 的累加和，均按 0xff 取模。
+     * 取模被推迟到每 BLOCK 字节一次；长数据在支持 SSSE3 时按 16 字节并行求和。
+     * 可跨片段多次 update，供流式解码时边收边校验。
+     */
+    class IsoChecksum {
+    public:
+        //c0、c1 从小于 0xff 开始，连续累加 BLOCK 字节不会溢出 32 位
+        static constexpr size_t BLOCK = 5552;
+
+        IsoChecksum() = default;
+
+        void reset() {
+            _c0 = 0;
+            _c1 = 0;
+        }
+
+        /**
+         * @brief 追加数据
+         * @param data 数据
+         * @param len 数据长度
+         */
+        void update(const unsigned char *data, size_t len) {
+            uint32_t c0 = _c0, c1 = _c1;
+            while (len > 0) {
+                size_t n = len < BLOCK ? len : BLOCK;
+                len -= n;
+#ifdef __SSSE3__
+                if (n >= 16) {
+                    size_t vec = n & ~static_cast<size_t>(15);
+                    sum16(data, vec, c0, c1);
+                    data += vec;
+                    n -= vec;
+                }
+#endif
+                while (n >= 4) {
+                    c0 += data[0];
+                    c1 += c0;
+                    c0 += data[1];
+                    c1 += c0;
+                    c0 += data[2];
+                    c1 += c0;
+                    c0 += data[3];
+                    c1 += c0;
+                    data += 4;
+                    n -= 4;
+                }
+                while (n--) {
+                    c0 += *data++;
+                    c1 += c0;
+                }
+                c0 %= 0xff;
+                c1 %= 0xff;
+            }
+            _c0 = c0;
+            _c1 = c1;
+        }
+
+        /**
+         * @brief 生成两字节校验码，写入 out[0..1]
+         */
+        void store(unsigned char *out) const {
+            unsigned char s0 = static_cast<unsigned char>((0xff - (_c0 + _c1) % 0xff) % 0xff);
+            unsigned char s1 = static_cast<unsigned char>(_c1 % 0xff);
+            out[0] = s0 == 0 ? 0xff : s0;
+            out[1] = s1 == 0 ? 0xff : s1;
+        }
+
+        /**
+         * @brief 数据连同校验码一起 update 后调用，判断校验是否通过
+         */
+        bool valid() const {
+            return _c0 % 0xff == 0 && _c1 % 0xff == 0;
+        }
+
+        uint32_t c0() const { return _c0; }
+
+        uint32_t c1() const { return _c1; }
+
+        /**
+         * @brief 计算校验码
+         * @param data 数据域
+         * @param len 数据域长度
+         * @param out 两字节校验码
+         */
+        static void compute(const unsigned char *data, size_t len, unsigned char *out) {
+            IsoChecksum sum;
+            sum.update(data, len);
+            sum.store(out);
+        }
+
+        /**
+         * @brief 校验数据域及紧随其后的两字节校验码
+         * @param data 数据域
+         * @param len 数据域长度（不含校验码）
+         * @return
+         */
+        static bool verify(const unsigned char *data, size_t len) {
+            if (data[len] == 0 || data[len + 1] == 0) {
+                return false;
+            }
+            IsoChecksum sum;
+            sum.update(data, len + 2);
+            return sum.valid();
+        }
+
+    private:
+#ifdef __SSSE3__
+        /**
+         * 16 字节一组：c1 += 16 * c0 + sum((16 - k) * b[k])，c0 += sum(b[k])
+         */
+        static void sum16(const unsigned char *data, size_t len, uint32_t &c0, uint32_t &c1) {
+            const __m128i weights = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+            const __m128i ones = _mm_set1_epi16(1);
+            const __m128i zero = _mm_setzero_si128();
+            __m128i vs1 = zero, vps = zero, vs2 = zero;
+            size_t chunks = len / 16;
+            for (size_t i = 0; i < chunks; i++) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 16));
+                vps = _mm_add_epi32(vps, vs1);
+                vs1 = _mm_add_epi32(vs1, _mm_sad_epu8(x, zero));
+                vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_maddubs_epi16(x, weights), ones));
+            }
+            c1 += static_cast<uint32_t>(chunks * 16) * c0 + 16 * hsum(vps) + hsum(vs2);
+            c0 += hsum(vs1);
+        }
+
+        static uint32_t hsum(__m128i v) {
+            v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+            v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+            return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+        }
+#endif
+
+        uint32_t _c0 = 0;
+        uint32_t _c1 = 0;
+    };
+}
@@ -0,0 +1,209 @@
+//
+// @Author: MorningXu
+// @Description: 编译期消息描述，生成 AA63 数据域编解码
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "BitConverter.hpp"
+#include "FrameDecoder.hpp"
+#include "FrameEncoder.hpp"
+
+namespace lanyueuav {
+    namespace detail {
+        template<typename M>
+        struct MemberTraits;
+
+        template<typename C, typename T>
+        struct MemberTraits<T C::*> {
+            using Class = C;
+            using Type = T;
+        };
+
+        template<typename T>
+        struct WireType {
+            static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                          "MessageSchema field must be arithmetic, enum or a fixed array of them");
+            using Element = T;
+            static constexpr size_t count = 1;
+        };
+
+        template<typename T, size_t N>
+        struct WireType<T[N]> {
+            using Element = T;
+            static constexpr size_t count = N;
+        };
+
+        template<typename T, size_t N>
+        struct WireType<std::array<T, N>> {
+            using Element = T;
+            static constexpr size_t count = N;
+        };
+
+        template<typename T, bool = std::is_enum<T>::value>
+        struct Scalar {
+            using type = T;
+        };
+
+        template<typename T>
+        struct Scalar<T, true> {
+            using type = typename std::underlying_type<T>::type;
+        };
+    }
+
+    /**
+     * @brief 消息字段：成员指针 + 字节序
+     *
+     * 支持整型、浮点、枚举（按底层类型编码）及它们的定长数组。
+     * @tparam Member 成员指针，例如 &Attitude::roll
+     * @tparam E 字节序，默认与 header_encode 一致的小端
+     */
+    template<auto Member, Endian E = Endian::Little>
+    struct Field {
+        using Class = typename detail::MemberTraits<decltype(Member)>::Class;
+        using Type = typename detail::MemberTraits<decltype(Member)>::Type;
+        using Element = typename detail::WireType<Type>::Element;
+        using Wire = typename detail::Scalar<Element>::type;
+        static constexpr size_t count = detail::WireType<Type>::count;
+        static constexpr size_t size = sizeof(Wire) * count;
+
+        static inline void encode(const Class &msg, unsigned char *out) {
+            if constexpr (count == 1) {
+                BitConverter::write<E>(static_cast<Wire>(msg.*Member), out);
+            } else {
+                for (size_t i = 0; i < count; i++) {
+                    BitConverter::write<E>(static_cast<Wire>((msg.*Member)[i]), out + i * sizeof(Wire));
+                }
+            }
+        }
+
+        static inline void decode(const unsigned char *in, Class &msg) {
+            if constexpr (count == 1) {
+                msg.*Member = static_cast<Element>(BitConverter::read<Wire, E>(in));
+            } else {
+                for (size_t i = 0; i < count; i++) {
+                    (msg.*Member)[i] = static_cast<Element>(BitConverter::read<Wire, E>(in + i * sizeof(Wire)));
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief 保留字节，编码时写 0，解码时跳过
+     */
+    template<size_t N>
+    struct Reserved {
+        static constexpr size_t size = N;
+
+        template<typename C>
+        static inline void encode(const C &, unsigned char *out) {
+            memset(out, 0, N);
+        }
+
+        template<typename C>
+        static inline void decode(const unsigned char *, C &) {}
+    };
+
+    /**
+     * @brief 消息描述，字段按声明顺序紧密排列，偏移与总长在编译期确定
+     *
+     * 示例：
+     * struct Attitude { uint32_t time_ms; float roll, pitch, yaw; };
+     * using AttitudeSchema = MessageSchema<Field<&Attitude::time_ms>, Field<&Attitude::roll>,
+     *                                      Field<&Attitude::pitch>, Field<&Attitude::yaw>>;
+     * unsigned char buf[AttitudeSchema::FRAME_SIZE];
+     * AttitudeSchema::encodeFrame(buf, att, 1, 2, 3, 4);
+     */
+    template<typename... Fields>
+    struct MessageSchema {
+        //数据域长
+        static constexpr size_t size = (Fields::size + ... + 0);
+        static_assert(size <= 0xffff, "MessageSchema payload exceeds the u16 length field");
+        static constexpr uint16_t length = static_cast<uint16_t>(size);
+        //整包长度
+        static constexpr size_t FRAME_SIZE = FrameEncoder::frameSize(length);
+        //指定校验策略时的整包长度
+        template<typename Policy>
+        static constexpr size_t frame_size = BasicFrameEncoder<Policy>::frameSize(length);
+
+        //各字段在数据域中的偏移
+        static constexpr std::array<size_t, sizeof...(Fields)> offsets = [] {
+            std::array<size_t, sizeof...(Fields)> result{};
+            size_t sizes[] = {Fields::size..., 0};
+            size_t offset = 0;
+            for (size_t i = 0; i < sizeof...(Fields); i++) {
+                result[i] = offset;
+                offset += sizes[i];
+            }
+            return result;
+        }();
+
+        /**
+         * @brief 编码数据域
+         * @param msg 消息
+         * @param out 输出，至少 size 字节
+         */
+        template<typename C>
+        static inline void encode(const C &msg, unsigned char *out) {
+            encode(msg, out, std::index_sequence_for<Fields...>{});
+        }
+
+        /**
+         * @brief 解码数据域
+         * @param in 数据域，至少 size 字节
+         * @param msg 消息
+         */
+        template<typename C>
+        static inline void decode(const unsigned char *in, C &msg) {
+            decode(in, msg, std::index_sequence_for<Fields...>{});
+        }
+
+        /**
+         * @brief 编码整包
+         * @tparam Policy 校验策略，默认 ISO 和校验
+         * @param out 输出，至少 frame_size<Policy> 字节
+         * @return 整包长度
+         */
+        template<typename Policy = IsoSumPolicy, typename C>
+        static inline size_t encodeFrame(unsigned char *out, const C &msg, uint8_t sender_group, uint8_t sender_id,
+                                         uint8_t reciver_group, uint8_t reciver_id) {
+            using Encoder = BasicFrameEncoder<Policy>;
+            Encoder::writeHeader(out, length, sender_group, sender_id, reciver_group, reciver_id);
+            unsigned char *payload = out + BasicFrameDecoder<Policy>::HEADER_SIZE;
+            encode(msg, payload);
+            Encoder::writeTail(payload + size, payload, length);
+            return frame_size<Policy>;
+        }
+
+        /**
+         * @brief 从解码得到的数据包中解析消息
+         * @return 数据域长与消息不符时返回 false
+         */
+        template<typename C>
+        static inline bool decodeFrame(const FrameView &frame, C &msg) {
+            if (frame.length != length) {
+                return false;
+            }
+            decode(frame.payload(), msg);
+            return true;
+        }
+
+    private:
+        template<typename C, size_t... I>
+        static inline void encode(const C &msg, unsigned char *out, std::index_sequence<I...>) {
+            (Fields::encode(msg, out + offsets[I]), ...);
+        }
+
+        template<typename C, size_t... I>
+        static inline void decode(const unsigned char *in, C &msg, std::index_sequence<I...>) {
+            (Fields::decode(in + offsets[I], msg), ...);
+        }
+    };
+}
@@ -0,0 +1,256 @@
+//
+// @Author: MorningXu
+// @Description: 多线程解码大体积原始数据文件
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "FrameDecoder.hpp"
+
+namespace lanyueuav {
+    /**
+     * @brief 并行批量解码器，结果与把整段数据一次性喂给 FrameDecoder 完全一致
+     *
+     * 数据按 chunk_size 切块，每个线程从块首独立重同步并记录本块内起始的数据包；
+     * 块边界处从上一块的结束位置沿顺序解码的轨迹逐步前进，直到落在本块扫描轨迹上
+     * （解码是位置的确定函数，轨迹一旦重合之后便完全相同），因此不会漏包或重复。
+     * 数据按轮处理（每轮 threads 个块），内存占用与文件大小无关，回调在调用线程中按顺序执行。
+     * @tparam Policy 校验策略，与 BasicFrameDecoder 一致
+     */
+    template<typename Policy>
+    class BasicParallelFrameDecoder {
+        using Decoder = BasicFrameDecoder<Policy>;
+
+    public:
+        using Callback = typename Decoder::Callback;
+
+        struct Result {
+            uint64_t frames;      //数据包数
+            uint64_t frameBytes;  //数据包总字节数
+            uint64_t skipped;     //未落在数据包内的字节数
+        };
+
+        /**
+         * @param threads 线程数，0 表示使用全部核心
+         * @param chunk_size 单个线程每轮处理的字节数
+         * @param max_length 允许的最大数据域长，与 FrameDecoder 一致
+         */
+        explicit BasicParallelFrameDecoder(unsigned threads = 0, size_t chunk_size = 16u << 20,
+                                           uint16_t max_length = 0xffff)
+                : _threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+                  _chunk_size(chunk_size ? chunk_size : 1), _max_length(max_length) {}
+
+        /**
+         * @brief 解码内存中的数据
+         * @param data 原始字节流
+         * @param size 长度
+         * @param callback 按顺序回调每个数据包，视图指向 data
+         */
+        Result decode(const unsigned char *data, size_t size, const Callback &callback) const {
+            Result result{0, 0, 0};
+            std::vector<Chunk> chunks(_threads);
+            std::vector<std::thread> workers;
+            size_t pos = 0;
+            bool done = false;
+            for (size_t round = 0; round < size && !done; round += _threads * _chunk_size) {
+                size_t count = 0;
+                for (; count < _threads; count++) {
+                    size_t begin = round + count * _chunk_size;
+                    if (begin >= size) break;
+                    chunks[count].reset(begin, std::min(size, begin + _chunk_size));
+                }
+                workers.clear();
+                for (size_t k = 1; k < count; k++) {
+                    workers.emplace_back([&, k] { scan(data, size, chunks[k]); });
+                }
+                scan(data, size, chunks[0]);
+                for (auto &worker: workers) worker.join();
+
+                for (size_t k = 0; k < count && !done; k++) {
+                    done = stitch(data, size, chunks[k], pos, result, callback);
+                }
+            }
+            result.skipped = size - result.frameBytes;
+            return result;
+        }
+
+        /**
+         * @brief 映射并解码原始字节流文件
+         * @param path 文件路径
+         * @param callback 按顺序回调每个数据包，视图仅在回调期间有效
+         * @param ok 文件无法打开或映射时置为 false
+         */
+        Result decodeFile(const std::string &path, const Callback &callback, bool *ok = nullptr) const {
+            Result result{0, 0, 0};
+            if (ok) *ok = false;
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return result;
+            }
+            struct stat st{};
+            if (fstat(fd, &st) != 0) {
+                ::close(fd);
+                return result;
+            }
+            auto size = static_cast<size_t>(st.st_size);
+            if (size == 0) {
+                ::close(fd);
+                if (ok) *ok = true;
+                return result;
+            }
+            void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (map == MAP_FAILED) {
+                return result;
+            }
+            madvise(map, size, MADV_SEQUENTIAL);
+            result = decode(static_cast<const unsigned char *>(map), size, callback);
+            munmap(map, size);
+            if (ok) *ok = true;
+            return result;
+        }
+
+    private:
+        enum Step {
+            StepFrame,  //当前位置是完整有效的数据包
+            StepSkip,   //前进一个字节
+            StepEnd     //数据包不完整，顺序解码在此停止
+        };
+
+        struct Frame {
+            size_t offset;
+            size_t size;
+        };
+
+        struct Chunk {
+            size_t begin;
+            size_t end;
+            size_t next;        //扫描停止位置
+            bool terminal;      //扫描在 next 处遇到不完整的数据包
+            std::vector<Frame> frames;
+
+            void reset(size_t b, size_t e) {
+                begin = b;
+                end = e;
+                next = b;
+                terminal = false;
+                frames.clear();
+            }
+        };
+
+        /**
+         * @brief 顺序解码在位置 i 的一步，与 FrameDecoder 在整段输入上的行为一致
+         */
+        Step step(const unsigned char *data, size_t total, size_t i, size_t &frame_size) const {
+            if (data[i] != Decoder::HEADER_0) {
+                return StepSkip;
+            }
+            size_t avail = total - i;
+            if (avail < 2) return StepEnd;
+            if (data[i + 1] != Decoder::HEADER_1) return StepSkip;
+            if (avail < 4) return StepEnd;
+            size_t size = Decoder::frameSize(data + i);
+            if (size - Decoder::OVERHEAD > _max_length) return StepSkip;
+            if (avail < size) return StepEnd;
+            if (!Decoder::validate(data + i, size)) return StepSkip;
+            frame_size = size;
+            return StepFrame;
+        }
+
+        void scan(const unsigned char *data, size_t total, Chunk &chunk) const {
+            size_t i = chunk.begin;
+            while (i < chunk.end) {
+                auto *hit = static_cast<const unsigned char *>(
+                        memchr(data + i, Decoder::HEADER_0, chunk.end - i));
+                if (hit == nullptr) {
+                    i = chunk.end;
+                    break;
+                }
+                i = static_cast<size_t>(hit - data);
+                size_t size = 0;
+                Step s = step(data, total, i, size);
+                if (s == StepFrame) {
+                    chunk.frames.push_back(Frame{i, size});
+                    i += size;
+                } else if (s == StepSkip) {
+                    i++;
+                } else {
+                    chunk.terminal = true;
+                    break;
+                }
+            }
+            chunk.next = i;
+        }
+
+        /**
+         * @brief 位置 q 是否在该块的扫描轨迹上（不在已识别数据包的内部，且不在终止位置之后）
+         * @param first 输出 q 之后（含）的第一个数据包下标
+         */
+        static bool onTrajectory(const Chunk &chunk, size_t q, size_t &first) {
+            if (chunk.terminal && q > chunk.next) {
+                return false;
+            }
+            auto it = std::lower_bound(chunk.frames.begin(), chunk.frames.end(), q,
+                                       [](const Frame &f, size_t v) { return f.offset < v; });
+            first = static_cast<size_t>(it - chunk.frames.begin());
+            if (it == chunk.frames.begin()) {
+                return true;
+            }
+            const Frame &prev = *(it - 1);
+            return q >= prev.offset + prev.size;
+        }
+
+        /**
+         * @brief 从顺序轨迹位置 pos 出发衔接本块结果并按顺序输出
+         * @return 顺序解码已终止
+         */
+        bool stitch(const unsigned char *data, size_t total, const Chunk &chunk, size_t &pos,
+                    Result &result, const Callback &callback) const {
+            while (pos < chunk.end) {
+                size_t first;
+                if (onTrajectory(chunk, pos, first)) {
+                    for (size_t f = first; f < chunk.frames.size(); f++) {
+                        emit(data, chunk.frames[f], result, callback);
+                    }
+                    pos = chunk.next;
+                    return chunk.terminal;
+                }
+                size_t size = 0;
+                Step s = step(data, total, pos, size);
+                if (s == StepFrame) {
+                    emit(data, Frame{pos, size}, result, callback);
+                    pos += size;
+                } else if (s == StepSkip) {
+                    pos++;
+                } else {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void emit(const unsigned char *data, const Frame &frame, Result &result, const Callback &callback) {
+            result.frames++;
+            result.frameBytes += frame.size;
+            if (callback) callback(Decoder::view(data + frame.offset, frame.size));
+        }
+
+        unsigned _threads;
+        size_t _chunk_size;
+        uint16_t _max_length;
+    };
+
+    using ParallelFrameDecoder = BasicParallelFrameDecoder<IsoSumPolicy>;
+}
@@ -0,0 +1,306 @@
+//
+// @Author: MorningXu
+// @Description: 单生产者单消费者无锁环形队列（字节流 / 数据包槽位）
+// @Date: 2026-10-18
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace lanyueuav {
+    namespace detail {
+        constexpr size_t CACHE_LINE = 64;
+
+        inline size_t roundUpPow2(size_t value) {
+            size_t cap = 1;
+            while (cap < value) cap <<= 1;
+            return cap;
+        }
+
+        /**
+         * @brief 读写游标，各自独占缓存行，并缓存对端游标以减少跨核读取
+         */
+        struct SpscCursors {
+            alignas(CACHE_LINE) std::atomic<size_t> head{0};  //消费者写
+            size_t cached_tail = 0;                           //消费者缓存的生产者游标
+            alignas(CACHE_LINE) std::atomic<size_t> tail{0};  //生产者写
+            size_t cached_head = 0;                           //生产者缓存的消费者游标
+        };
+    }
+
+    /**
+     * @brief 字节流环形队列，读串口线程与解码线程之间传递原始字节
+     *
+     * 生产者可通过 writeRegion/publish 让 SerialPort::read 直接写入空闲区，无需中间拷贝；
+     * 消费者通过 readRegion/consume 直接在队列内存上解码。
+     */
+    class SpscByteRing {
+    public:
+        explicit SpscByteRing(size_t capacity = 1u << 16)
+                : _capacity(detail::roundUpPow2(capacity)), _mask(_capacity - 1),
+                  _buf(new unsigned char[_capacity]) {}
+
+        SpscByteRing(const SpscByteRing &) = delete;
+
+        SpscByteRing &operator=(const SpscByteRing &) = delete;
+
+        size_t capacity() const { return _capacity; }
+
+        /**
+         * @brief 生产者：获取连续空闲区
+         * @param len 输出连续空闲区长度
+         * @return 空闲区起始地址
+         */
+        unsigned char *writeRegion(size_t &len) {
+            size_t tail = _c.tail.load(std::memory_order_relaxed);
+            if (_capacity - (tail - _c.cached_head) == 0) {
+                _c.cached_head = _c.head.load(std::memory_order_acquire);
+            }
+            size_t space = _capacity - (tail - _c.cached_head);
+            size_t pos = tail & _mask;
+            len = space < _capacity - pos ? space : _capacity - pos;
+            return _buf.get() + pos;
+        }
+
+        /**
+         * @brief 生产者：发布通过 writeRegion 写入的 n 个字节
+         */
+        void publish(size_t n) {
+            _c.tail.store(_c.tail.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+        /**
+         * @brief 生产者：拷贝写入，空间不足时只写入能容纳的部分
+         * @return 实际写入的字节数
+         */
+        size_t push(const unsigned char *data, size_t len) {
+            size_t done = 0;
+            while (done < len) {
+                size_t region;
+                unsigned char *dst = writeRegion(region);
+                if (region == 0) break;
+                if (region > len - done) region = len - done;
+                memcpy(dst, data + done, region);
+                publish(region);
+                done += region;
+            }
+            return done;
+        }
+
+        /**
+         * @brief 生产者：从数据源（SerialPort 或回放源）直接读入空闲区
+         * @param source 提供 int read(void *, int) 的对象
+         * @return read 的返回值，队列满时返回 0
+         */
+        template<typename Source>
+        int readFrom(Source &source) {
+            size_t region;
+            unsigned char *dst = writeRegion(region);
+            if (region == 0) {
+                return 0;
+            }
+            int n = source.read(dst, static_cast<int>(region));
+            if (n > 0) publish(static_cast<size_t>(n));
+            return n;
+        }
+
+        /**
+         * @brief 消费者：获取连续可读区
+         * @param len 输出连续可读区长度
+         * @return 可读区起始地址
+         */
+        const unsigned char *readRegion(size_t &len) {
+            size_t head = _c.head.load(std::memory_order_relaxed);
+            if (_c.cached_tail == head) {
+                _c.cached_tail = _c.tail.load(std::memory_order_acquire);
+            }
+            size_t avail = _c.cached_tail - head;
+            size_t pos = head & _mask;
+            len = avail < _capacity - pos ? avail : _capacity - pos;
+            return _buf.get() + pos;
+        }
+
+        /**
+         * @brief 消费者：释放 n 个已处理的字节
+         */
+        void consume(size_t n) {
+            _c.head.store(_c.head.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+        /**
+         * @brief 消费者：拷贝读出
+         * @return 实际读出的字节数
+         */
+        size_t pop(unsigned char *out, size_t len) {
+            size_t done = 0;
+            while (done < len) {
+                size_t region;
+                const unsigned char *src = readRegion(region);
+                if (region == 0) break;
+                if (region > len - done) region = len - done;
+                memcpy(out + done, src, region);
+                consume(region);
+                done += region;
+            }
+            return done;
+        }
+
+        //可读字节数，任意线程调用时仅为近似值
+        size_t size() const {
+            //先读 head：tail 只增不减，不会读到比 head 旧的 tail；两次读取之间生产者可能再写入，因此限制在容量内
+            size_t head = _c.head.load(std::memory_order_acquire);
+            size_t used = _c.tail.load(std::memory_order_acquire) - head;
+            return used < _capacity ? used : _capacity;
+        }
+
+    private:
+        size_t _capacity;
+        size_t _mask;
+        std::unique_ptr<unsigned char[]> _buf;
+        detail::SpscCursors _c;
+    };
+
+    /**
+     * @brief 定长槽位环形队列，传递解码后的数据包
+     *
+     * 每个槽位前 4 字节记录数据长度。生产者 acquire 取得空槽位直接写入，publish 批量发布；
+     * 消费者 front/pop 逐个处理，或 consume 批量处理后一次性释放槽位。
+     */
+    class SpscFrameRing {
+    public:
+        /**
+         * @param slots 槽位数，向上取整为 2 的幂
+         * @param slot_size 单个槽位可容纳的最大数据长度
+         */
+        SpscFrameRing(size_t slots, size_t slot_size)
+                : _slots(detail::roundUpPow2(slots)), _mask(_slots - 1),
+                  _stride(slot_size + sizeof(uint32_t)), _slot_size(slot_size),
+                  _buf(new unsigned char[_slots * _stride]) {}
+
+        SpscFrameRing(const SpscFrameRing &) = delete;
+
+        SpscFrameRing &operator=(const SpscFrameRing &) = delete;
+
+        size_t slots() const { return _slots; }
+
+        size_t slotSize() const { return _slot_size; }
+
+        /**
+         * @brief 生产者：取得第 index 个未发布的空槽位（index 从 0 开始，用于批量写入）
+         * @return 槽位数据区，队列满时返回 nullptr
+         */
+        unsigned char *acquire(size_t index = 0) {
+            size_t pos = _c.tail.load(std::memory_order_relaxed) + index;
+            if (pos - _c.cached_head >= _slots) {
+                _c.cached_head = _c.head.load(std::memory_order_acquire);
+                if (pos - _c.cached_head >= _slots) return nullptr;
+            }
+            return slot(pos) + sizeof(uint32_t);
+        }
+
+        /**
+         * @brief 生产者：设置第 index 个未发布槽位的数据长度
+         */
+        void setSize(size_t index, size_t size) {
+            auto len = static_cast<uint32_t>(size);
+            memcpy(slot(_c.tail.load(std::memory_order_relaxed) + index), &len, sizeof(len));
+        }
+
+        /**
+         * @brief 生产者：发布 count 个已写入的槽位
+         */
+        void publish(size_t count = 1) {
+            _c.tail.store(_c.tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+
+        /**
+         * @brief 生产者：拷贝一个数据包并发布
+         * @return 队列满或数据超长时返回 false
+         */
+        bool push(const unsigned char *data, size_t size) {
+            if (size > _slot_size) {
+                return false;
+            }
+            unsigned char *dst = acquire();
+            if (dst == nullptr) {
+                return false;
+            }
+            memcpy(dst, data, size);
+            setSize(0, size);
+            publish();
+            return true;
+        }
+
+        /**
+         * @brief 消费者：查看队首数据包
+         * @return 队列为空时返回 false
+         */
+        bool front(const unsigned char *&data, size_t &size) {
+            size_t head = _c.head.load(std::memory_order_relaxed);
+            if (_c.cached_tail == head) {
+                _c.cached_tail = _c.tail.load(std::memory_order_acquire);
+                if (_c.cached_tail == head) return false;
+            }
+            const unsigned char *s = slot(head);
+            uint32_t len;
+            memcpy(&len, s, sizeof(len));
+            data = s + sizeof(len);
+            size = len;
+            return true;
+        }
+
+        /**
+         * @brief 消费者：释放队首 count 个槽位
+         */
+        void pop(size_t count = 1) {
+            _c.head.store(_c.head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+
+        /**
+         * @brief 消费者：批量处理最多 max 个数据包后一次性释放槽位
+         * @param fn 处理函数 void(const unsigned char *data, size_t size)
+         * @return 处理的数据包数
+         */
+        template<typename Fn>
+        size_t consume(Fn &&fn, size_t max = SIZE_MAX) {
+            size_t head = _c.head.load(std::memory_order_relaxed);
+            _c.cached_tail = _c.tail.load(std::memory_order_acquire);
+            size_t count = _c.cached_tail - head;
+            if (count > max) count = max;
+            for (size_t i = 0; i < count; i++) {
+                const unsigned char *s = slot(head + i);
+                uint32_t len;
+                memcpy(&len, s, sizeof(len));
+                fn(s + sizeof(len), static_cast<size_t>(len));
+            }
+            if (count) _c.head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        //已发布未处理的数据包数，任意线程调用时仅为近似值
+        size_t size() const {
+            size_t head = _c.head.load(std::memory_order_acquire);
+            size_t used = _c.tail.load(std::memory_order_acquire) - head;
+            return used < _slots ? used : _slots;
+        }
+
+        bool empty() const { return size() == 0; }
+
+    private:
+        unsigned char *slot(size_t pos) const {
+            return _buf.get() + (pos & _mask) * _stride;
+        }
+
+        size_t _slots;
+        size_t _mask;
+        size_t _stride;
+        size_t _slot_size;
+        std::unique_ptr<unsigned char[]> _buf;
+        detail::SpscCursors _c;
+    };
+}